@@ -0,0 +1,290 @@
+//********************************************************* 
+// 
+// Copyright (c) Microsoft. All rights reserved. 
+// This code is licensed under the MIT License (MIT). 
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF 
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY 
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR 
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT. 
+// 
+//*********************************************************
+
+#include "pch.h"
+#include "BatchRunner.h"
+#include "SweptCollision.h"
+
+using namespace DirectX;
+
+//----------------------------------------------------------------------
+
+BatchRunner::BatchRunner(
+    unsigned int instanceCount,
+    std::function<Level^()> const& createLevel,
+    std::function<void(std::vector<GameObject^>& objects)> const& createObjects,
+    _In_ JobSystem* jobs
+    ) :
+    m_jobs(jobs),
+    m_createLevel(createLevel),
+    m_levels(instanceCount),
+    m_objects(instanceCount),
+    m_time(instanceCount),
+    m_timeRemaining(instanceCount),
+    m_finished(instanceCount),
+    m_won(instanceCount),
+    m_nextAmmo(instanceCount),
+    m_x(instanceCount * AmmoStride),
+    m_y(instanceCount * AmmoStride),
+    m_z(instanceCount * AmmoStride),
+    m_vx(instanceCount * AmmoStride),
+    m_vy(instanceCount * AmmoStride),
+    m_vz(instanceCount * AmmoStride),
+    m_active(instanceCount * AmmoStride)
+{
+    LARGE_INTEGER frequency;
+    if (!QueryPerformanceFrequency(&frequency))
+    {
+        throw ref new Platform::FailureException();
+    }
+    m_secondsPerCount = 1.0 / static_cast<double>(frequency.QuadPart);
+
+    for (unsigned int instance = 0; instance < instanceCount; instance++)
+    {
+        createObjects(m_objects[instance]);
+    }
+    Reset();
+}
+
+//----------------------------------------------------------------------
+
+void BatchRunner::Reset()
+{
+    for (unsigned int instance = 0; instance < InstanceCount(); instance++)
+    {
+        m_levels[instance] = m_createLevel();
+        m_levels[instance]->Initialize(m_objects[instance]);
+        m_time[instance] = 0.0f;
+        m_timeRemaining[instance] = m_levels[instance]->TimeLimit();
+        m_finished[instance] = 0;
+        m_won[instance] = 0;
+        m_nextAmmo[instance] = 0;
+    }
+    std::fill(m_active.begin(), m_active.end(), 0.0f);
+    m_instanceSteps = 0;
+    m_stepCounts.QuadPart = 0;
+}
+
+//----------------------------------------------------------------------
+
+void BatchRunner::Fire(
+    unsigned int instance,
+    XMFLOAT3 position,
+    XMFLOAT3 velocity
+    )
+{
+    if (m_finished[instance])
+    {
+        return;
+    }
+
+    unsigned int lane = instance * AmmoStride + m_nextAmmo[instance];
+    m_nextAmmo[instance] = (m_nextAmmo[instance] + 1) % GameConstants::MaxAmmo;
+    m_x[lane] = position.x;
+    m_y[lane] = position.y;
+    m_z[lane] = position.z;
+    m_vx[lane] = velocity.x;
+    m_vy[lane] = velocity.y;
+    m_vz[lane] = velocity.z;
+    m_active[lane] = 1.0f;
+}
+
+//----------------------------------------------------------------------
+
+void BatchRunner::Step(float timeDelta)
+{
+    unsigned int running = 0;
+    for (auto finished = m_finished.begin(); finished != m_finished.end(); finished++)
+    {
+        running += (*finished == 0) ? 1 : 0;
+    }
+
+    LARGE_INTEGER start;
+    LARGE_INTEGER end;
+    QueryPerformanceCounter(&start);
+
+    m_jobs->ParallelFor(0, InstanceCount(), InstanceGrain, [this, timeDelta](unsigned int first, unsigned int last)
+    {
+        StepInstances(first, last, timeDelta);
+    });
+
+    QueryPerformanceCounter(&end);
+    m_stepCounts.QuadPart += end.QuadPart - start.QuadPart;
+    m_instanceSteps += running;
+}
+
+//----------------------------------------------------------------------
+
+double BatchRunner::StepsPerSecond()
+{
+    double seconds = m_stepCounts.QuadPart * m_secondsPerCount;
+    return (seconds > 0.0) ? m_instanceSteps / seconds : 0.0;
+}
+
+//----------------------------------------------------------------------
+
+void BatchRunner::StepInstances(unsigned int first, unsigned int last, float timeDelta)
+{
+    ApplyGravity(first * AmmoStride, last * AmmoStride, timeDelta);
+
+    for (unsigned int instance = first; instance < last; instance++)
+    {
+        if (m_finished[instance])
+        {
+            continue;
+        }
+
+        // Move the animated objects, as the game does before testing for collisions.
+        float time = m_time[instance] + timeDelta;
+        std::vector<GameObject^>& objects = m_objects[instance];
+        for (auto object = objects.begin(); object != objects.end(); object++)
+        {
+            Animate^ animate = (*object)->AnimatePosition();
+            if (animate != nullptr && animate->IsActive(time))
+            {
+                (*object)->Position(animate->Evaluate(time));
+            }
+        }
+        m_time[instance] = time;
+
+        SweepAmmo(instance, timeDelta);
+    }
+
+    ContainAmmo(first * AmmoStride, last * AmmoStride);
+
+    for (unsigned int instance = first; instance < last; instance++)
+    {
+        if (m_finished[instance])
+        {
+            continue;
+        }
+
+        if (m_levels[instance]->Update(m_time[instance], timeDelta, m_timeRemaining[instance], m_objects[instance]))
+        {
+            m_won[instance] = 1;
+            m_finished[instance] = 1;
+        }
+        m_timeRemaining[instance] -= timeDelta;
+        if (m_timeRemaining[instance] <= 0.0f)
+        {
+            m_finished[instance] = 1;
+        }
+        if (m_finished[instance])
+        {
+            // Park the instance's ammo so that the batched passes leave it alone.
+            auto lanes = m_active.begin() + instance * AmmoStride;
+            std::fill(lanes, lanes + AmmoStride, 0.0f);
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+
+void BatchRunner::ApplyGravity(unsigned int firstLane, unsigned int lastLane, float timeDelta)
+{
+    // Lanes of finished instances and idle lanes have m_active at 0 and are left as they are.
+    XMVECTOR gravityStep = XMVectorReplicate(GameConstants::Physics::Gravity * timeDelta);
+    for (unsigned int lane = firstLane; lane < lastLane; lane += 4)
+    {
+        XMVECTOR active = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(&m_active[lane]));
+        XMVECTOR vy = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(&m_vy[lane]));
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&m_vy[lane]), XMVectorNegativeMultiplySubtract(active, gravityStep, vy));
+    }
+}
+
+//----------------------------------------------------------------------
+
+void BatchRunner::SweepAmmo(unsigned int instance, float timeDelta)
+{
+    std::vector<GameObject^> const& objects = m_objects[instance];
+    unsigned int firstLane = instance * AmmoStride;
+    for (unsigned int lane = firstLane; lane < firstLane + GameConstants::MaxAmmo; lane++)
+    {
+        if (m_active[lane] == 0.0f)
+        {
+            continue;
+        }
+
+        XMFLOAT3 point(m_x[lane], m_y[lane], m_z[lane]);
+        XMFLOAT3 velocity(m_vx[lane], m_vy[lane], m_vz[lane]);
+        float remaining = timeDelta;
+        for (int impacts = 0; impacts < GameConstants::MaxImpactsPerFrame && remaining > 0.0f; impacts++)
+        {
+            XMFLOAT3 motion(velocity.x * remaining, velocity.y * remaining, velocity.z * remaining);
+            Impact impact;
+            if (!FirstImpact(point, GameConstants::AmmoRadius, motion, objects, nullptr, &impact))
+            {
+                point = XMFLOAT3(point.x + motion.x, point.y + motion.y, point.z + motion.z);
+                remaining = 0.0f;
+                break;
+            }
+
+            XMStoreFloat3(&point, XMLoadFloat3(&point) + XMLoadFloat3(&motion) * impact.t);
+            remaining -= remaining * impact.t;
+
+            // Bounce off the object, losing the same share of speed as on the walls.
+            XMVECTOR normal = XMLoadFloat3(&impact.normal);
+            XMVECTOR v = XMLoadFloat3(&velocity);
+            v = XMVectorScale(XMVector3Reflect(v, normal), GameConstants::Physics::GroundRestitution);
+            XMStoreFloat3(&velocity, v);
+
+            if (impact.object->Target())
+            {
+                impact.object->Hit(true);
+                impact.object->HitTime(m_time[instance]);
+            }
+        }
+
+        m_x[lane] = point.x;
+        m_y[lane] = point.y;
+        m_z[lane] = point.z;
+        m_vx[lane] = velocity.x;
+        m_vy[lane] = velocity.y;
+        m_vz[lane] = velocity.z;
+    }
+}
+
+//----------------------------------------------------------------------
+
+void BatchRunner::ContainAmmo(unsigned int firstLane, unsigned int lastLane)
+{
+    // Keep the ammo inside the world box, bouncing off the floor, ceiling and walls.
+    const float radius = GameConstants::AmmoRadius;
+    XMVECTOR restitution = XMVectorReplicate(-GameConstants::Physics::GroundRestitution);
+    XMVECTOR limits[3] =
+    {
+        XMVectorReplicate(GameConstants::World::HalfWidth - radius),
+        XMVectorReplicate(GameConstants::World::HalfHeight - radius),
+        XMVectorReplicate(GameConstants::World::HalfDepth - radius),
+    };
+    std::vector<float>* positions[3] = { &m_x, &m_y, &m_z };
+    std::vector<float>* velocities[3] = { &m_vx, &m_vy, &m_vz };
+
+    for (unsigned int lane = firstLane; lane < lastLane; lane += 4)
+    {
+        for (int axis = 0; axis < 3; axis++)
+        {
+            XMFLOAT4* positionLanes = reinterpret_cast<XMFLOAT4*>(&(*positions[axis])[lane]);
+            XMFLOAT4* velocityLanes = reinterpret_cast<XMFLOAT4*>(&(*velocities[axis])[lane]);
+            XMVECTOR p = XMLoadFloat4(positionLanes);
+            XMVECTOR v = XMLoadFloat4(velocityLanes);
+
+            // Idle lanes hold stale values; clamping them as well is harmless.
+            XMVECTOR outside = XMVectorGreater(XMVectorAbs(p), limits[axis]);
+            XMVECTOR movingIn = XMVectorLess(XMVectorMultiply(p, v), XMVectorZero());
+            XMVECTOR bounce = XMVectorAndCInt(outside, movingIn);
+            XMStoreFloat4(positionLanes, XMVectorClamp(p, XMVectorNegate(limits[axis]), limits[axis]));
+            XMStoreFloat4(velocityLanes, XMVectorSelect(v, XMVectorMultiply(v, restitution), bounce));
+        }
+    }
+}
+
+//----------------------------------------------------------------------
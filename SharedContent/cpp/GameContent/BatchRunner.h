@@ -0,0 +1,132 @@
+//********************************************************* 
+// 
+// Copyright (c) Microsoft. All rights reserved. 
+// This code is licensed under the MIT License (MIT). 
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF 
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY 
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR 
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT. 
+// 
+//*********************************************************
+
+#pragma once
+
+// BatchRunner:
+// Runs many independent game sessions in lockstep, for training and balancing agents
+// where the number of simulated steps per second is what matters.  Each instance has its
+// own Level and its own objects and goes through the same contract as the game: Level
+// Initialize places the objects, and after every step Level Update decides whether the
+// level is complete.  Nothing is rendered and no sound is played.
+//
+// The ammo of all instances is kept in shared structure-of-arrays buffers, instance
+// after instance, each padded to a multiple of four lanes.  Gravity and the walls of
+// the world box are applied to four lanes at a time across instances.  Impacts with an
+// instance's own objects are found with FirstImpact, so fast ammo doesn't pass through
+// targets.  Instances are spread over the JobSystem in chunks, and each instance is only
+// touched by the job that owns it.
+//
+// createObjects is called once per instance and must return objects of its own, since
+// instances are stepped in parallel.  Ammo does not collide with other ammo here; the
+// agents are scored on targets.
+
+#include "Level.h"
+#include "GameConstants.h"
+#include "JobSystem.h"
+
+ref class BatchRunner
+{
+internal:
+    BatchRunner(
+        unsigned int instanceCount,
+        std::function<Level^()> const& createLevel,
+        std::function<void(std::vector<GameObject^>& objects)> const& createObjects,
+        _In_ JobSystem* jobs
+        );
+
+    // Initializes every instance's level and clears its ammo and clock.
+    void Reset();
+
+    // Launches the instance's next round of ammo, reusing the oldest once all are in flight.
+    void Fire(
+        unsigned int instance,
+        DirectX::XMFLOAT3 position,
+        DirectX::XMFLOAT3 velocity
+        );
+
+    // Advances every instance that has not finished by timeDelta.
+    void Step(float timeDelta);
+
+    unsigned int InstanceCount();
+    bool Finished(unsigned int instance);       // Completed the level or ran out of time.
+    bool Won(unsigned int instance);
+    float TimeRemaining(unsigned int instance);
+    std::vector<GameObject^> const& Objects(unsigned int instance);
+
+    // Instance steps taken since Reset and their rate over the wall time spent in Step.
+    unsigned __int64 InstanceSteps();
+    double StepsPerSecond();
+
+private:
+    static const unsigned int AmmoStride = (GameConstants::MaxAmmo + 3) & ~3u;
+    static const unsigned int InstanceGrain = 16;
+
+    void StepInstances(unsigned int first, unsigned int last, float timeDelta);
+    void ApplyGravity(unsigned int firstLane, unsigned int lastLane, float timeDelta);
+    void SweepAmmo(unsigned int instance, float timeDelta);
+    void ContainAmmo(unsigned int firstLane, unsigned int lastLane);
+
+    JobSystem*                              m_jobs;
+    std::function<Level^()>                 m_createLevel;
+
+    // Per instance.
+    std::vector<Level^>                     m_levels;
+    std::vector<std::vector<GameObject^>>   m_objects;
+    std::vector<float>                      m_time;
+    std::vector<float>                      m_timeRemaining;
+    std::vector<unsigned char>              m_finished;
+    std::vector<unsigned char>              m_won;
+    std::vector<unsigned int>               m_nextAmmo;
+
+    // Per ammo lane, AmmoStride lanes per instance.
+    std::vector<float>                      m_x;
+    std::vector<float>                      m_y;
+    std::vector<float>                      m_z;
+    std::vector<float>                      m_vx;
+    std::vector<float>                      m_vy;
+    std::vector<float>                      m_vz;
+    std::vector<float>                      m_active;   // 1 for ammo in flight, 0 otherwise.
+
+    unsigned __int64                        m_instanceSteps;
+    LARGE_INTEGER                           m_stepCounts;
+    double                                  m_secondsPerCount;
+};
+
+__forceinline unsigned int BatchRunner::InstanceCount()
+{
+    return static_cast<unsigned int>(m_levels.size());
+}
+
+__forceinline bool BatchRunner::Finished(unsigned int instance)
+{
+    return m_finished[instance] != 0;
+}
+
+__forceinline bool BatchRunner::Won(unsigned int instance)
+{
+    return m_won[instance] != 0;
+}
+
+__forceinline float BatchRunner::TimeRemaining(unsigned int instance)
+{
+    return m_timeRemaining[instance];
+}
+
+__forceinline std::vector<GameObject^> const& BatchRunner::Objects(unsigned int instance)
+{
+    return m_objects[instance];
+}
+
+__forceinline unsigned __int64 BatchRunner::InstanceSteps()
+{
+    return m_instanceSteps;
+}
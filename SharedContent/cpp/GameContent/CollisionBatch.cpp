@@ -0,0 +1,121 @@
+//********************************************************* 
+// 
+// Copyright (c) Microsoft. All rights reserved. 
+// This code is licensed under the MIT License (MIT). 
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF 
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY 
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR 
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT. 
+// 
+//*********************************************************
+
+#include "pch.h"
+#include "CollisionBatch.h"
+
+using namespace DirectX;
+
+namespace
+{
+    // Loads four consecutive floats, or the ones that are left followed by fill.
+    inline XMVECTOR LoadLanes(_In_ float const* values, unsigned int count, float fill)
+    {
+        if (count >= 4)
+        {
+            return XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(values));
+        }
+        XMFLOAT4A lanes(fill, fill, fill, fill);
+        float* lane = &lanes.x;
+        for (unsigned int i = 0; i < count; i++)
+        {
+            lane[i] = values[i];
+        }
+        return XMLoadFloat4A(&lanes);
+    }
+}
+
+//----------------------------------------------------------------------
+
+unsigned int CollideSpheresWithFaces(
+    SphereBatch const& spheres,
+    _In_reads_(faceCount) FaceFrame const* faces,
+    unsigned int faceCount,
+    ContactBatch const& contacts
+    )
+{
+    unsigned int written = 0;
+    for (unsigned int first = 0; first < spheres.count; first += 4)
+    {
+        unsigned int lanes = spheres.count - first;
+
+        // A negative radius never touches, so the lanes past the end stay quiet.
+        XMVECTOR x = LoadLanes(spheres.x + first, lanes, 0.0f);
+        XMVECTOR y = LoadLanes(spheres.y + first, lanes, 0.0f);
+        XMVECTOR z = LoadLanes(spheres.z + first, lanes, 0.0f);
+        XMVECTOR radius = LoadLanes(spheres.radius + first, lanes, -1.0f);
+
+        for (unsigned int f = 0; f < faceCount; f++)
+        {
+            FaceFrame const& face = faces[f];
+            XMVECTOR dx = XMVectorSubtract(x, XMVectorReplicate(face.center.x));
+            XMVECTOR dy = XMVectorSubtract(y, XMVectorReplicate(face.center.y));
+            XMVECTOR dz = XMVectorSubtract(z, XMVectorReplicate(face.center.z));
+
+            XMVECTOR dist = XMVectorMultiplyAdd(dz, XMVectorReplicate(face.normal.z),
+                XMVectorMultiplyAdd(dy, XMVectorReplicate(face.normal.y),
+                XMVectorMultiply(dx, XMVectorReplicate(face.normal.x))));
+            XMVECTOR across0 = XMVectorMultiplyAdd(dz, XMVectorReplicate(face.axis[0].z),
+                XMVectorMultiplyAdd(dy, XMVectorReplicate(face.axis[0].y),
+                XMVectorMultiply(dx, XMVectorReplicate(face.axis[0].x))));
+            XMVECTOR across1 = XMVectorMultiplyAdd(dz, XMVectorReplicate(face.axis[1].z),
+                XMVectorMultiplyAdd(dy, XMVectorReplicate(face.axis[1].y),
+                XMVectorMultiply(dx, XMVectorReplicate(face.axis[1].x))));
+
+            XMVECTOR touching = XMVectorAndInt(
+                XMVectorLess(XMVectorAbs(dist), radius),
+                XMVectorAndInt(
+                    XMVectorLess(XMVectorAbs(across0), XMVectorAdd(radius, XMVectorReplicate(face.extent[0]))),
+                    XMVectorLess(XMVectorAbs(across1), XMVectorAdd(radius, XMVectorReplicate(face.extent[1])))
+                    )
+                );
+            if (XMVector4EqualInt(touching, XMVectorFalseInt()))
+            {
+                continue;
+            }
+
+            // Rare: write out the lanes that touch.
+            XMFLOAT4A laneDist;
+            XMUINT4 laneTouching;
+            XMStoreFloat4A(&laneDist, dist);
+            XMStoreUInt4(&laneTouching, touching);
+            float const* distances = &laneDist.x;
+            uint32_t const* touches = &laneTouching.x;
+            for (unsigned int lane = 0; lane < 4; lane++)
+            {
+                if (touches[lane] == 0)
+                {
+                    continue;
+                }
+                if (written == contacts.capacity)
+                {
+                    return written;
+                }
+
+                unsigned int sphere = first + lane;
+                float d = distances[lane];
+                float side = (d < 0.0f) ? -1.0f : 1.0f;
+                contacts.sphere[written] = sphere;
+                contacts.face[written] = f;
+                contacts.contactX[written] = spheres.x[sphere] - face.normal.x * d;
+                contacts.contactY[written] = spheres.y[sphere] - face.normal.y * d;
+                contacts.contactZ[written] = spheres.z[sphere] - face.normal.z * d;
+                contacts.normalX[written] = face.normal.x * side;
+                contacts.normalY[written] = face.normal.y * side;
+                contacts.normalZ[written] = face.normal.z * side;
+                written++;
+            }
+        }
+    }
+    return written;
+}
+
+//----------------------------------------------------------------------
@@ -0,0 +1,55 @@
+//********************************************************* 
+// 
+// Copyright (c) Microsoft. All rights reserved. 
+// This code is licensed under the MIT License (MIT). 
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF 
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY 
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR 
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT. 
+// 
+//*********************************************************
+
+#pragma once
+
+// CollisionBatch:
+// Tests many spheres against many faces at once.  The spheres are given as separate
+// x, y, z and radius arrays and are processed four to a vector register, so each face
+// frame is loaded once for every four spheres instead of once per IsTouching call.  The
+// test is the same as Face::IsTouching: within radius of the plane and inside both slabs
+// of the face's frame extended by the radius.
+//
+// Every touching pair is appended to the contact arrays, which have room for capacity
+// pairs.  The contact is the projection of the sphere center onto the plane and the
+// normal points from the face toward the center.
+
+#include "Face.h"
+
+struct SphereBatch
+{
+    float const* x;
+    float const* y;
+    float const* z;
+    float const* radius;
+    unsigned int count;
+};
+
+struct ContactBatch
+{
+    unsigned int* sphere;
+    unsigned int* face;
+    float*        contactX;
+    float*        contactY;
+    float*        contactZ;
+    float*        normalX;
+    float*        normalY;
+    float*        normalZ;
+    unsigned int  capacity;
+};
+
+// Returns the number of pairs written, at most contacts.capacity.
+unsigned int CollideSpheresWithFaces(
+    SphereBatch const& spheres,
+    _In_reads_(faceCount) FaceFrame const* faces,
+    unsigned int faceCount,
+    ContactBatch const& contacts
+    );
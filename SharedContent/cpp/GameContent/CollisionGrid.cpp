@@ -0,0 +1,216 @@
+//********************************************************* 
+// 
+// Copyright (c) Microsoft. All rights reserved. 
+// This code is licensed under the MIT License (MIT). 
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF 
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY 
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR 
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT. 
+// 
+//*********************************************************
+
+#include "pch.h"
+#include "CollisionGrid.h"
+#include "GameConstants.h"
+
+using namespace DirectX;
+
+//----------------------------------------------------------------------
+
+CollisionGrid::CollisionGrid()
+{
+    Initialize(
+        XMFLOAT3(-GameConstants::World::HalfWidth, -GameConstants::World::HalfHeight, -GameConstants::World::HalfDepth),
+        XMFLOAT3(GameConstants::World::HalfWidth, GameConstants::World::HalfHeight, GameConstants::World::HalfDepth),
+        GameConstants::World::CellSize
+        );
+}
+
+//----------------------------------------------------------------------
+
+CollisionGrid::CollisionGrid(
+    XMFLOAT3 minimum,
+    XMFLOAT3 maximum,
+    float cellSize
+    )
+{
+    Initialize(minimum, maximum, cellSize);
+}
+
+//----------------------------------------------------------------------
+
+void CollisionGrid::Initialize(
+    XMFLOAT3 minimum,
+    XMFLOAT3 maximum,
+    float cellSize
+    )
+{
+    m_minimum = minimum;
+    m_inverseCellSize = 1.0f / cellSize;
+    m_cellCount[0] = max(1, static_cast<int>(ceilf((maximum.x - minimum.x) * m_inverseCellSize)));
+    m_cellCount[1] = max(1, static_cast<int>(ceilf((maximum.y - minimum.y) * m_inverseCellSize)));
+    m_cellCount[2] = max(1, static_cast<int>(ceilf((maximum.z - minimum.z) * m_inverseCellSize)));
+    m_cells.resize(m_cellCount[0] * m_cellCount[1] * m_cellCount[2]);
+    m_queryStamp = 0;
+}
+
+//----------------------------------------------------------------------
+
+void CollisionGrid::Clear()
+{
+    for (auto cell = m_cells.begin(); cell != m_cells.end(); cell++)
+    {
+        cell->clear();
+    }
+    m_entries.clear();
+}
+
+//----------------------------------------------------------------------
+
+void CollisionGrid::Insert(_In_ GameObject^ object)
+{
+    Entry entry;
+    entry.object = object;
+    entry.version = object->PositionVersion();
+    entry.queryStamp = 0;
+    m_entries.push_back(entry);
+    Place(static_cast<unsigned int>(m_entries.size() - 1));
+}
+
+//----------------------------------------------------------------------
+
+void CollisionGrid::Update()
+{
+    for (unsigned int i = 0; i < m_entries.size(); i++)
+    {
+        unsigned int version = m_entries[i].object->PositionVersion();
+        if (version != m_entries[i].version)
+        {
+            m_entries[i].version = version;
+            Unplace(i);
+            Place(i);
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+
+void CollisionGrid::Candidates(
+    XMFLOAT3 point,
+    float radius,
+    _Inout_ std::vector<GameObject^>& candidates
+    )
+{
+    if (++m_queryStamp == 0)
+    {
+        // The stamp wrapped around; forget every earlier query.
+        for (auto entry = m_entries.begin(); entry != m_entries.end(); entry++)
+        {
+            entry->queryStamp = 0;
+        }
+        m_queryStamp = 1;
+    }
+
+    CellRange range = CellsOf(
+        XMFLOAT3(point.x - radius, point.y - radius, point.z - radius),
+        XMFLOAT3(point.x + radius, point.y + radius, point.z + radius)
+        );
+    for (int z = range.low[2]; z <= range.high[2]; z++)
+    {
+        for (int y = range.low[1]; y <= range.high[1]; y++)
+        {
+            for (int x = range.low[0]; x <= range.high[0]; x++)
+            {
+                std::vector<unsigned int>& cell = m_cells[Cell(x, y, z)];
+                for (auto index = cell.begin(); index != cell.end(); index++)
+                {
+                    Entry& entry = m_entries[*index];
+                    if (entry.queryStamp != m_queryStamp)
+                    {
+                        entry.queryStamp = m_queryStamp;
+                        if (entry.object->Active())
+                        {
+                            candidates.push_back(entry.object);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+
+CollisionGrid::CellRange CollisionGrid::CellsOf(XMFLOAT3 minimum, XMFLOAT3 maximum)
+{
+    float low[3] = { minimum.x - m_minimum.x, minimum.y - m_minimum.y, minimum.z - m_minimum.z };
+    float high[3] = { maximum.x - m_minimum.x, maximum.y - m_minimum.y, maximum.z - m_minimum.z };
+
+    CellRange range;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        // Clamp in floating point first so that far away objects cannot overflow the cast.
+        float last = static_cast<float>(m_cellCount[axis] - 1);
+        range.low[axis] = static_cast<int>(min(max(floorf(low[axis] * m_inverseCellSize), 0.0f), last));
+        range.high[axis] = static_cast<int>(min(max(floorf(high[axis] * m_inverseCellSize), 0.0f), last));
+    }
+    return range;
+}
+
+//----------------------------------------------------------------------
+
+int CollisionGrid::Cell(int x, int y, int z)
+{
+    return (z * m_cellCount[1] + y) * m_cellCount[0] + x;
+}
+
+//----------------------------------------------------------------------
+
+void CollisionGrid::Place(unsigned int entry)
+{
+    XMFLOAT3 minimum;
+    XMFLOAT3 maximum;
+    m_entries[entry].object->Bounds(&minimum, &maximum);
+
+    CellRange range = CellsOf(minimum, maximum);
+    m_entries[entry].cells = range;
+    for (int z = range.low[2]; z <= range.high[2]; z++)
+    {
+        for (int y = range.low[1]; y <= range.high[1]; y++)
+        {
+            for (int x = range.low[0]; x <= range.high[0]; x++)
+            {
+                m_cells[Cell(x, y, z)].push_back(entry);
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+
+void CollisionGrid::Unplace(unsigned int entry)
+{
+    CellRange const& range = m_entries[entry].cells;
+    for (int z = range.low[2]; z <= range.high[2]; z++)
+    {
+        for (int y = range.low[1]; y <= range.high[1]; y++)
+        {
+            for (int x = range.low[0]; x <= range.high[0]; x++)
+            {
+                // Cells hold a handful of entries, so a swap with the last one is enough.
+                std::vector<unsigned int>& cell = m_cells[Cell(x, y, z)];
+                for (auto index = cell.begin(); index != cell.end(); index++)
+                {
+                    if (*index == entry)
+                    {
+                        *index = cell.back();
+                        cell.pop_back();
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------
@@ -0,0 +1,80 @@
+//********************************************************* 
+// 
+// Copyright (c) Microsoft. All rights reserved. 
+// This code is licensed under the MIT License (MIT). 
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF 
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY 
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR 
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT. 
+// 
+//*********************************************************
+
+#pragma once
+
+// CollisionGrid:
+// This class is a broadphase for the collision tests.  It divides the world box into
+// uniform cells and lists each object in every cell its bounding box overlaps, so that
+// an ammo sphere is only tested with IsTouching against the objects that share a cell
+// with it instead of against every object in the level.
+//
+// Objects are placed when inserted.  Update places again only the objects whose
+// PositionVersion changed since they were last placed; walls and fixed targets are
+// never revisited.  Anything outside the world box is kept in the border cells, so it is
+// still found, just less selectively.
+
+#include "GameObject.h"
+
+ref class CollisionGrid
+{
+internal:
+    // A grid over the world box defined in GameConstants::World.
+    CollisionGrid();
+    CollisionGrid(
+        DirectX::XMFLOAT3 minimum,
+        DirectX::XMFLOAT3 maximum,
+        float cellSize
+        );
+
+    void Clear();
+    void Insert(_In_ GameObject^ object);
+    void Update();
+
+    // Appends every active object whose cells overlap the box around the sphere, once.
+    void Candidates(
+        DirectX::XMFLOAT3 point,
+        float radius,
+        _Inout_ std::vector<GameObject^>& candidates
+        );
+
+private:
+    struct CellRange
+    {
+        int low[3];
+        int high[3];
+    };
+
+    struct Entry
+    {
+        GameObject^  object;
+        unsigned int version;
+        CellRange    cells;
+        unsigned int queryStamp;
+    };
+
+    void Initialize(
+        DirectX::XMFLOAT3 minimum,
+        DirectX::XMFLOAT3 maximum,
+        float cellSize
+        );
+    CellRange CellsOf(DirectX::XMFLOAT3 minimum, DirectX::XMFLOAT3 maximum);
+    int Cell(int x, int y, int z);
+    void Place(unsigned int entry);
+    void Unplace(unsigned int entry);
+
+    DirectX::XMFLOAT3                      m_minimum;
+    float                                  m_inverseCellSize;
+    int                                    m_cellCount[3];
+    std::vector<Entry>                     m_entries;
+    std::vector<std::vector<unsigned int>> m_cells;
+    unsigned int                           m_queryStamp;
+};
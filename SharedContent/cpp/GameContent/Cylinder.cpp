@@ -11,6 +11,7 @@
 
 #include "pch.h"
 #include "Cylinder.h"
+#include "SweptCollision.h"
 
 using namespace DirectX;
 
@@ -41,6 +42,7 @@ void Cylinder::Initialize(
     )
 {
     m_position = position;
+    m_positionVersion++;
     m_radius = radius;
     m_length = XMVectorGetX(XMVector3Length(XMLoadFloat3(&direction)));
     XMStoreFloat3(&m_axis, XMVector3Normalize(XMLoadFloat3(&direction)));
@@ -82,6 +84,21 @@ void Cylinder::UpdatePosition()
 
 //--------------------------------------------------------------------------------
 
+void Cylinder::Bounds(
+    _Out_ XMFLOAT3 *minimum,
+    _Out_ XMFLOAT3 *maximum
+    )
+{
+    // The box around both end caps; a little loose for a tilted cylinder.
+    XMVECTOR p0 = XMLoadFloat3(&m_position);
+    XMVECTOR p1 = p0 + XMLoadFloat3(&m_axis) * m_length;
+    XMVECTOR radius = XMVectorReplicate(m_radius);
+    XMStoreFloat3(minimum, XMVectorMin(p0, p1) - radius);
+    XMStoreFloat3(maximum, XMVectorMax(p0, p1) + radius);
+}
+
+//--------------------------------------------------------------------------------
+
 bool Cylinder::IsTouching(
     XMFLOAT3 point,
     float radius,
@@ -138,3 +155,45 @@ bool Cylinder::IsTouching(
 }
 
 //--------------------------------------------------------------------------------
+
+bool Cylinder::TimeOfImpact(
+    XMFLOAT3 point,
+    float radius,
+    XMFLOAT3 motion,
+    _Out_ float *t,
+    _Out_ XMFLOAT3 *contact,
+    _Out_ XMFLOAT3 *normal
+    )
+{
+    // IsTouching holds while the center projects onto the axis between the end points and
+    // is within radius + m_radius of the axis line.
+    XMVECTOR offset = XMLoadFloat3(&point) - XMLoadFloat3(&m_position);
+    XMVECTOR move = XMLoadFloat3(&motion);
+    XMVECTOR axis = XMLoadFloat3(&m_axis);
+    float along = XMVectorGetX(XMVector3Dot(offset, axis));
+    float alongRate = XMVectorGetX(XMVector3Dot(move, axis));
+    float enter = 0.0f;
+    float exit = 1.0f;
+
+    if (!SweptCollision::ClipSlab(along - m_length * 0.5f, alongRate, m_length * 0.5f, &enter, &exit) ||
+        !SweptCollision::ClipRound(offset - axis * along, move - axis * alongRate, radius + m_radius, &enter, &exit))
+    {
+        return false;
+    }
+
+    XMFLOAT3 impactPoint;
+    XMStoreFloat3(&impactPoint, XMLoadFloat3(&point) + move * enter);
+    XMFLOAT3 impactContact;
+    XMFLOAT3 impactNormal;
+    IsTouching(impactPoint, radius, &impactContact, &impactNormal);
+    if (!(enter > 0.0f || XMVectorGetX(XMVector3Dot(move, XMLoadFloat3(&impactNormal))) < 0.0f))
+    {
+        return false;
+    }
+    *t = enter;
+    *contact = impactContact;
+    *normal = impactNormal;
+    return true;
+}
+
+//--------------------------------------------------------------------------------
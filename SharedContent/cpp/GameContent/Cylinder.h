@@ -29,6 +29,11 @@ internal:
         DirectX::XMFLOAT3 direction
         );
 
+    virtual void Bounds(
+        _Out_ DirectX::XMFLOAT3 *minimum,
+        _Out_ DirectX::XMFLOAT3 *maximum
+        ) override;
+
     virtual bool IsTouching(
         DirectX::XMFLOAT3 point,
         float radius,
@@ -36,6 +41,15 @@ internal:
         _Out_ DirectX::XMFLOAT3 *normal
         ) override;
 
+    virtual bool TimeOfImpact(
+        DirectX::XMFLOAT3 point,
+        float radius,
+        DirectX::XMFLOAT3 motion,
+        _Out_ float *t,
+        _Out_ DirectX::XMFLOAT3 *contact,
+        _Out_ DirectX::XMFLOAT3 *normal
+        ) override;
+
 protected:
     virtual void UpdatePosition() override;
 
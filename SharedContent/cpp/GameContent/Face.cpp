@@ -11,6 +11,7 @@
 
 #include "pch.h"
 #include "Face.h"
+#include "SweptCollision.h"
 
 using namespace DirectX;
 
@@ -45,6 +46,7 @@ void Face::SetPlane(
     )
 {
     m_position = origin;
+    m_positionVersion++;
     XMStoreFloat3(&m_widthVector, XMLoadFloat3(&p1) - XMLoadFloat3(&origin));
     XMStoreFloat3(&m_heightVector, XMLoadFloat3(&p2) - XMLoadFloat3(&origin));
 
@@ -66,6 +68,7 @@ void Face::SetPlane(
             )
         );
     UpdateMatrix();
+    UpdateFrame();
 }
 
 //--------------------------------------------------------------------------------
@@ -83,6 +86,48 @@ void Face::UpdatePosition()
         XMLoadFloat4x4(&m_rotationMatrix) *
         XMMatrixTranslation(m_position.x, m_position.y, m_position.z)
         );
+    UpdateFrame();
+}
+
+//--------------------------------------------------------------------------------
+
+void Face::UpdateFrame()
+{
+    XMVECTOR normal = XMLoadFloat3(&m_normal);
+    XMVECTOR width = XMLoadFloat3(&m_widthVector);
+    XMVECTOR height = XMLoadFloat3(&m_heightVector);
+    XMVECTOR acrossWidth = XMVector3Normalize(XMVector3Cross(normal, width));
+    XMVECTOR acrossHeight = XMVector3Normalize(XMVector3Cross(height, normal));
+
+    XMStoreFloat3(&m_frame.center, XMLoadFloat3(&m_position) + (width + height) * 0.5f);
+    m_frame.normal = m_normal;
+    XMStoreFloat3(&m_frame.axis[0], acrossWidth);
+    XMStoreFloat3(&m_frame.axis[1], acrossHeight);
+
+    // IsTouching used to accept a point when its distance to each edge line was less than
+    // the distance between the opposite edges plus the radius.  That is a slab centered
+    // between the edges; for a slanted parallelogram the edges are closer than the height
+    // or width, which widens the slab.
+    m_frame.extent[0] = m_height - 0.5f * fabsf(XMVectorGetX(XMVector3Dot(height, acrossWidth)));
+    m_frame.extent[1] = m_width - 0.5f * fabsf(XMVectorGetX(XMVector3Dot(width, acrossHeight)));
+}
+
+//--------------------------------------------------------------------------------
+
+void Face::Bounds(
+    _Out_ XMFLOAT3 *minimum,
+    _Out_ XMFLOAT3 *maximum
+    )
+{
+    XMVECTOR low = XMLoadFloat3(&m_point[0]);
+    XMVECTOR high = low;
+    for (int i = 1; i < 4; i++)
+    {
+        low = XMVectorMin(low, XMLoadFloat3(&m_point[i]));
+        high = XMVectorMax(high, XMLoadFloat3(&m_point[i]));
+    }
+    XMStoreFloat3(minimum, low);
+    XMStoreFloat3(maximum, high);
 }
 
 //--------------------------------------------------------------------------------
@@ -94,101 +139,24 @@ bool Face::IsTouching(
     _Out_ XMFLOAT3 *normal
     )
 {
-    float dist;
-
     // Determine if a point is within radius distance of the face and
     // return the point of contact (projection of the point onto the face).
 
-    XMStoreFloat(
-        &dist,
-        XMVector3Dot(
-            XMLoadFloat3(&m_normal),
-            XMLoadFloat3(&point) - XMLoadFloat3(&m_position)
-            )
-        );
+    XMVECTOR offset = XMLoadFloat3(&point) - XMLoadFloat3(&m_frame.center);
+    XMVECTOR faceNormal = XMLoadFloat3(&m_frame.normal);
+    float dist = XMVectorGetX(XMVector3Dot(faceNormal, offset));
 
     // Determine the point of contact by projecting the point along the Normal
     // vector the distance the point is from the plane.
-    XMStoreFloat3(contact, XMLoadFloat3(&point) - (XMLoadFloat3(&m_normal) * dist));
-    normal->x = m_normal.x;
-    normal->y = m_normal.y;
-    normal->z = m_normal.z;
-
-    if (dist < 0.0f)
-    {
-        dist *= -1.0f;
-        normal->x = -m_normal.x;
-        normal->y = -m_normal.y;
-        normal->z = -m_normal.z;
-    }
-    else
-    {
-        normal->x = m_normal.x;
-        normal->y = m_normal.y;
-        normal->z = m_normal.z;
-    }
-
-    if (dist < radius)
-    {
-        // point is within radius of the plane
-        //
-        // Determine if the point of contact is inside the parallelogram of the target.
-        // This is true if distance from each of the parallel lines defining the half
-        // spaces is less than the distance between the parallel lines for both sets of
-        // parallel lines.
-        // To catch the cases where the contact point is just outside the parallelogram
-        // but less than the radius we extend the parallelogram to accept points that are
-        // the distance between the parallel lines plus the radius.
-        //
-
-        float dist1, dist2, dist3, dist4;
-
-        XMStoreFloat(
-            &dist1,
-            XMVector3LinePointDistance(
-                XMLoadFloat3(&m_point[0]),
-                XMLoadFloat3(&m_point[1]),
-                XMLoadFloat3(contact)
-                )
-            );
-        XMStoreFloat(
-            &dist2,
-            XMVector3LinePointDistance(
-                XMLoadFloat3(&m_point[3]),
-                XMLoadFloat3(&m_point[2]),
-                XMLoadFloat3(contact)
-                )
-            );
-        XMStoreFloat(
-            &dist3,
-            XMVector3LinePointDistance(
-                XMLoadFloat3(&m_point[0]),
-                XMLoadFloat3(&m_point[3]),
-                XMLoadFloat3(contact)
-                )
-            );
-        XMStoreFloat(
-            &dist4,
-            XMVector3LinePointDistance(
-                XMLoadFloat3(&m_point[1]),
-                XMLoadFloat3(&m_point[2]),
-                XMLoadFloat3(contact)
-                )
-            );
-
-        if (dist1 < (m_height + radius) &&
-            dist2 < (m_height + radius) &&
-            dist3 < (m_width + radius) &&
-            dist4 < (m_width + radius))
-        {
-            return true;
-        }
-        else
-        {
-            return false;
-        }
-    }
-    return false;
+    XMStoreFloat3(contact, XMLoadFloat3(&point) - (faceNormal * dist));
+    XMStoreFloat3(normal, (dist < 0.0f) ? -faceNormal : faceNormal);
+
+    // The point of contact is over the face, extended by the radius on every side, when
+    // it is inside both slabs of the frame.  The projection along the normal doesn't
+    // change the dot products with the in-plane axes, so the offset can be used directly.
+    return fabsf(dist) < radius &&
+        fabsf(XMVectorGetX(XMVector3Dot(offset, XMLoadFloat3(&m_frame.axis[0])))) < m_frame.extent[0] + radius &&
+        fabsf(XMVectorGetX(XMVector3Dot(offset, XMLoadFloat3(&m_frame.axis[1])))) < m_frame.extent[1] + radius;
 }
 
 //--------------------------------------------------------------------------------
@@ -268,4 +236,57 @@ void Face::UpdateMatrix()
         );
 }
 
-//--------------------------------------------------------------------------------
\ No newline at end of file
+//--------------------------------------------------------------------------------
+
+bool Face::TimeOfImpact(
+    XMFLOAT3 point,
+    float radius,
+    XMFLOAT3 motion,
+    _Out_ float *t,
+    _Out_ XMFLOAT3 *contact,
+    _Out_ XMFLOAT3 *normal
+    )
+{
+    // IsTouching holds while the center is within radius of the plane and inside both slabs
+    // of the frame, each widened by the radius.
+    XMVECTOR offset = XMLoadFloat3(&point) - XMLoadFloat3(&m_frame.center);
+    XMVECTOR move = XMLoadFloat3(&motion);
+    XMVECTOR faceNormal = XMLoadFloat3(&m_frame.normal);
+    XMVECTOR axis0 = XMLoadFloat3(&m_frame.axis[0]);
+    XMVECTOR axis1 = XMLoadFloat3(&m_frame.axis[1]);
+    float enter = 0.0f;
+    float exit = 1.0f;
+
+    if (!SweptCollision::ClipSlab(
+            XMVectorGetX(XMVector3Dot(faceNormal, offset)),
+            XMVectorGetX(XMVector3Dot(faceNormal, move)),
+            radius, &enter, &exit) ||
+        !SweptCollision::ClipSlab(
+            XMVectorGetX(XMVector3Dot(axis0, offset)),
+            XMVectorGetX(XMVector3Dot(axis0, move)),
+            m_frame.extent[0] + radius, &enter, &exit) ||
+        !SweptCollision::ClipSlab(
+            XMVectorGetX(XMVector3Dot(axis1, offset)),
+            XMVectorGetX(XMVector3Dot(axis1, move)),
+            m_frame.extent[1] + radius, &enter, &exit))
+    {
+        return false;
+    }
+
+    // The normal points to the side the sphere is on, so a sphere moving along it is leaving.
+    XMFLOAT3 impactPoint;
+    XMStoreFloat3(&impactPoint, XMLoadFloat3(&point) + move * enter);
+    XMFLOAT3 impactContact;
+    XMFLOAT3 impactNormal;
+    IsTouching(impactPoint, radius, &impactContact, &impactNormal);
+    if (!(enter > 0.0f || XMVectorGetX(XMVector3Dot(move, XMLoadFloat3(&impactNormal))) < 0.0f))
+    {
+        return false;
+    }
+    *t = enter;
+    *contact = impactContact;
+    *normal = impactNormal;
+    return true;
+}
+
+//--------------------------------------------------------------------------------
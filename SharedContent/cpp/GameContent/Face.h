@@ -15,9 +15,24 @@
 // This class is a specialization of GameObject that represents a parallelogram primitive.
 // The face is defined by three points.  It is positioned at 'origin'.  The four corners
 // of the face are defined at 'origin', 'p1', 'p2' and 'p1' + ('p2' - 'origin').
+//
+// The face also keeps itself in a local frame for the collision tests: its center, its
+// normal and, for each pair of parallel edges, the unit vector in the plane that is
+// perpendicular to them together with the half distance a point may be from the center
+// along that vector.  For a rectangle these are the normalized height and width vectors
+// and half the height and width.  Testing whether a point is over the face is then two
+// dot products and two compares.
 
 #include "GameObject.h"
 
+struct FaceFrame
+{
+    DirectX::XMFLOAT3 center;
+    DirectX::XMFLOAT3 normal;
+    DirectX::XMFLOAT3 axis[2];      // Across the width edges, then across the height edges.
+    float             extent[2];
+};
+
 ref class Face: public GameObject
 {
 internal:
@@ -34,6 +49,11 @@ internal:
         DirectX::XMFLOAT3 p2
         );
 
+    virtual void Bounds(
+        _Out_ DirectX::XMFLOAT3 *minimum,
+        _Out_ DirectX::XMFLOAT3 *maximum
+        ) override;
+
     virtual bool IsTouching(
         DirectX::XMFLOAT3 point,
         float radius,
@@ -41,11 +61,23 @@ internal:
         _Out_ DirectX::XMFLOAT3 *normal
         ) override;
 
+    virtual bool TimeOfImpact(
+        DirectX::XMFLOAT3 point,
+        float radius,
+        DirectX::XMFLOAT3 motion,
+        _Out_ float *t,
+        _Out_ DirectX::XMFLOAT3 *contact,
+        _Out_ DirectX::XMFLOAT3 *normal
+        ) override;
+
+    FaceFrame const& Frame();
+
 protected:
     virtual void UpdatePosition() override;
 
 private:
     void UpdateMatrix();
+    void UpdateFrame();
 
     DirectX::XMFLOAT3   m_widthVector;
     DirectX::XMFLOAT3   m_heightVector;
@@ -54,4 +86,10 @@ private:
     float               m_width;
     float               m_height;
     DirectX::XMFLOAT4X4 m_rotationMatrix;
+    FaceFrame           m_frame;
 };
+
+__forceinline FaceFrame const& Face::Frame()
+{
+    return m_frame;
+}
@@ -0,0 +1,68 @@
+//********************************************************* 
+// 
+// Copyright (c) Microsoft. All rights reserved. 
+// This code is licensed under the MIT License (MIT). 
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF 
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY 
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR 
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT. 
+// 
+//*********************************************************
+
+#include "pch.h"
+#include "FixedStepClock.h"
+
+//----------------------------------------------------------------------
+
+FixedStepClock::FixedStepClock(
+    _In_ GameTimer^ timer,
+    float stepsPerSecond,
+    int maxSteps
+    ) :
+    m_timer(timer),
+    m_stepLength(1.0f / stepsPerSecond),
+    m_maxSteps(maxSteps)
+{
+    Reset();
+}
+
+//----------------------------------------------------------------------
+
+void FixedStepClock::Reset()
+{
+    m_accumulated = 0.0f;
+    m_stepCount = 0;
+    m_droppedTime = 0.0f;
+}
+
+//----------------------------------------------------------------------
+
+int FixedStepClock::Update()
+{
+    // DeltaTime is zero while the timer is stopped, so a paused game takes no steps and
+    // keeps its partial step for when it resumes.
+    m_accumulated += m_timer->DeltaTime();
+
+    float budget = m_stepLength * m_maxSteps;
+    if (m_accumulated > budget)
+    {
+        m_droppedTime += m_accumulated - budget;
+        m_accumulated = budget;
+    }
+
+    int steps = static_cast<int>(m_accumulated / m_stepLength);
+    if (steps > m_maxSteps)
+    {
+        // Only possible through rounding when the budget is exactly used up.
+        steps = m_maxSteps;
+    }
+    m_accumulated -= steps * m_stepLength;
+    if (m_accumulated < 0.0f)
+    {
+        m_accumulated = 0.0f;
+    }
+    m_stepCount += steps;
+    return steps;
+}
+
+//----------------------------------------------------------------------
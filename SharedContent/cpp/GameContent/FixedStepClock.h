@@ -0,0 +1,87 @@
+//********************************************************* 
+// 
+// Copyright (c) Microsoft. All rights reserved. 
+// This code is licensed under the MIT License (MIT). 
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF 
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY 
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR 
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT. 
+// 
+//*********************************************************
+
+#pragma once
+
+// FixedStepClock:
+// This class turns the variable frame time measured by a GameTimer into a whole number
+// of fixed length simulation steps.  The time that is not yet a full step is carried over
+// to the next frame, and Alpha tells the renderer how far the present is between the
+// last two steps, so that it can interpolate positions instead of showing the jitter of
+// whole steps.
+//
+// A long frame (a hitch, the debugger, the window being dragged) would otherwise ask for
+// many steps at once, which makes the next frame long as well.  Update never asks for more
+// than maxSteps; the time beyond that is dropped and the game runs a little slow for one
+// frame instead.
+//
+// Typical use, once per rendered frame:
+//     timer->Update();
+//     for (int step = clock->Update(); step > 0; step--)
+//     {
+//         Simulate(clock->StepLength());
+//     }
+//     Render(clock->Alpha());
+
+#include "GameTimer.h"
+
+ref class FixedStepClock
+{
+internal:
+    FixedStepClock(
+        _In_ GameTimer^ timer,
+        float stepsPerSecond,
+        int maxSteps
+        );
+
+    // Returns the number of steps to simulate for the time elapsed since the last call.
+    int Update();
+    void Reset();
+
+    float StepLength();
+    float Alpha();                  // 0 at the last step, approaching 1 just before the next one.
+    double SimulationTime();        // Steps taken since Reset, in seconds.
+    unsigned __int64 StepCount();
+    float DroppedTime();            // Time discarded by the catch-up budget since Reset.
+
+private:
+    GameTimer^       m_timer;
+    float            m_stepLength;
+    int              m_maxSteps;
+    float            m_accumulated;
+    unsigned __int64 m_stepCount;
+    float            m_droppedTime;
+};
+
+__forceinline float FixedStepClock::StepLength()
+{
+    return m_stepLength;
+}
+
+__forceinline float FixedStepClock::Alpha()
+{
+    return m_accumulated / m_stepLength;
+}
+
+__forceinline double FixedStepClock::SimulationTime()
+{
+    return static_cast<double>(m_stepCount) * m_stepLength;
+}
+
+__forceinline unsigned __int64 FixedStepClock::StepCount()
+{
+    return m_stepCount;
+}
+
+__forceinline float FixedStepClock::DroppedTime()
+{
+    return m_droppedTime;
+}
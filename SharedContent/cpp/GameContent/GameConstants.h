@@ -27,6 +27,15 @@ namespace GameConstants
     static const int WorldCeilingId             = 80002;
     static const int WorldWallsId               = 80003;
 
+    namespace World
+    {
+        // The world is the box WorldMesh draws: x in [-4, 4], y in [-3, 3], z in [-6, 6].
+        static const float HalfWidth            = 4.0f;
+        static const float HalfHeight           = 3.0f;
+        static const float HalfDepth            = 6.0f;
+        static const float CellSize             = 1.0f;     // Edge of a collision broadphase cell.
+    }
+
     namespace Physics
     {
         static const float GroundRestitution    = 0.8f;     // Percentage of the velocity transmitted by ground and walls when an ammo hit.
@@ -38,6 +47,11 @@ namespace GameConstants
         static const float RestThreshold        = 0.02f;    // The energy below which the ball is flagged as laying on ground.
                                                             // It is defined as Gravity * Height_above_ground + 0.5 * Velocity * Velocity.
         static const float FrameLength          = 0.003f;   // The duration of a frame for physics handling when the graphics frame length is too long.
+                                                            // Not needed when collisions are swept with FirstImpact.
+        static const float StepsPerSecond       = 120.0f;   // The rate of the fixed step simulation clock.
+        static const int MaxStepsPerFrame       = 8;        // The catch-up budget: simulation time beyond this many steps in one frame is dropped.
+        static const int MaxImpactsPerFrame     = 8;        // The number of impacts an ammo resolves in one frame with FirstImpact before
+                                                            // the rest of its motion is dropped.
     }
 
     namespace Sound
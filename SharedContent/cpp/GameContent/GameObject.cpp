@@ -13,6 +13,7 @@
 #include "GameObject.h"
 #include "ConstantBuffers.h"
 #include "GameConstants.h"
+#include "ObjectiveTracker.h"
 
 using namespace DirectX;
 
@@ -36,6 +37,10 @@ GameObject::GameObject() :
     XMStoreFloat4x4(&m_modelMatrix, XMMatrixIdentity());
 
     m_hitTime         = 0.0f;
+    m_positionVersion = 0;
+
+    m_tracker         = nullptr;
+    m_trackerIndex    = 0;
 
     m_animatePosition = nullptr;
 }
@@ -74,6 +79,16 @@ void GameObject::Render(
 
 //----------------------------------------------------------------------
 
+void GameObject::NotifyTracker()
+{
+    if (m_tracker != nullptr)
+    {
+        m_tracker->OnChanged(this, m_trackerIndex);
+    }
+}
+
+//----------------------------------------------------------------------
+
 void GameObject::PlaySound(float impactSpeed, XMFLOAT3 eyePoint)
 {
     if (m_hitSound != nullptr)
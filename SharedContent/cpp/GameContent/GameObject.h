@@ -20,12 +20,26 @@
 // the object's proximity to a point.  It is expected the sub-classes will replace this method.
 // The Render method will be called during rendering to include the object in the generation of
 // the scene.
+//
+// Bounds returns an axis-aligned box around the object for the collision broadphase, and
+// PositionVersion changes whenever the position or shape changes, so the broadphase only
+// has to look again at objects that have moved.
+//
+// TimeOfImpact is the continuous form of IsTouching: it sweeps the sphere by 'motion' and
+// returns the fraction of the motion at which IsTouching first becomes true, with the
+// contact and normal there.  A sphere that already touches the object at the start counts
+// only if it is moving further in.  The outputs are only set when it returns true.
+//
+// An object can be watched by one ObjectiveTracker, which is told whenever Active, Target,
+// Hit or TargetId changes.
 
 #include "MeshObject.h"
 #include "SoundEffect.h"
 #include "Animate.h"
 #include "Material.h"
 
+class ObjectiveTracker;
+
 ref class GameObject
 {
 internal:
@@ -44,6 +58,31 @@ internal:
         return false;
     };
 
+    // Expect the TimeOfImpact method to be overloaded by subclasses.
+    virtual bool TimeOfImpact(
+        DirectX::XMFLOAT3 /* point */,
+        float /* radius */,
+        DirectX::XMFLOAT3 /* motion */,
+        _Out_ float * /* t */,
+        _Out_ DirectX::XMFLOAT3 * /* contact */,
+        _Out_ DirectX::XMFLOAT3 * /* normal */
+        )
+    {
+        return false;
+    };
+
+    // Expect the Bounds method to be overloaded by subclasses with an extent.
+    virtual void Bounds(
+        _Out_ DirectX::XMFLOAT3 *minimum,
+        _Out_ DirectX::XMFLOAT3 *maximum
+        )
+    {
+        *minimum = m_position;
+        *maximum = m_position;
+    };
+
+    unsigned int PositionVersion();
+
     void Render(
         _In_ ID3D11DeviceContext *context,
         _In_ ID3D11Buffer *primitiveConstantBuffer
@@ -62,6 +101,9 @@ internal:
     void HitTime(float t);
     float HitTime();
 
+    void Tracker(_In_opt_ ObjectiveTracker* tracker, unsigned int index);
+    ObjectiveTracker* Tracker();
+
     void     AnimatePosition(_In_opt_ Animate^ animate);
     Animate^ AnimatePosition();
 
@@ -71,6 +113,7 @@ internal:
     void PlaySound(float impactSpeed, DirectX::XMFLOAT3 eyePoint);
 
     void Mesh(_In_ MeshObject^ mesh);
+    MeshObject^ Mesh();
 
     void NormalMaterial(_In_ Material^ material);
     Material^ NormalMaterial();
@@ -89,6 +132,7 @@ internal:
 
 protected private:
     virtual void UpdatePosition() {};
+    void NotifyTracker();
     // Object Data
     bool                m_active;
     bool                m_target;
@@ -108,6 +152,10 @@ protected private:
     DirectX::XMFLOAT3   m_defaultZAxis;
 
     float               m_hitTime;
+    unsigned int        m_positionVersion;
+
+    ObjectiveTracker*   m_tracker;
+    unsigned int        m_trackerIndex;
 
     Animate^            m_animatePosition;
     MeshObject^         m_mesh;
@@ -118,7 +166,11 @@ protected private:
 
 __forceinline void GameObject::Active(bool active)
 {
-    m_active = active;
+    if (m_active != active)
+    {
+        m_active = active;
+        NotifyTracker();
+    }
 }
 
 __forceinline bool GameObject::Active()
@@ -128,7 +180,11 @@ __forceinline bool GameObject::Active()
 
 __forceinline void GameObject::Target(bool target)
 {
-    m_target = target;
+    if (m_target != target)
+    {
+        m_target = target;
+        NotifyTracker();
+    }
 }
 
 __forceinline bool GameObject::Target()
@@ -138,7 +194,11 @@ __forceinline bool GameObject::Target()
 
 __forceinline void GameObject::Hit(bool hit)
 {
-    m_hit = hit;
+    if (m_hit != hit)
+    {
+        m_hit = hit;
+        NotifyTracker();
+    }
 }
 
 __forceinline bool GameObject::Hit()
@@ -158,7 +218,11 @@ __forceinline bool GameObject::OnGround()
 
 __forceinline void GameObject::TargetId(int targetId)
 {
-    m_targetId = targetId;
+    if (m_targetId != targetId)
+    {
+        m_targetId = targetId;
+        NotifyTracker();
+    }
 }
 
 __forceinline int GameObject::TargetId()
@@ -176,9 +240,26 @@ __forceinline float GameObject::HitTime()
     return m_hitTime;
 }
 
+__forceinline void GameObject::Tracker(_In_opt_ ObjectiveTracker* tracker, unsigned int index)
+{
+    m_tracker = tracker;
+    m_trackerIndex = index;
+}
+
+__forceinline ObjectiveTracker* GameObject::Tracker()
+{
+    return m_tracker;
+}
+
+__forceinline unsigned int GameObject::PositionVersion()
+{
+    return m_positionVersion;
+}
+
 __forceinline void GameObject::Position(DirectX::XMFLOAT3 position)
 {
     m_position = position;
+    m_positionVersion++;
     // Update any internal states that are dependent on the position.
     // UpdatePosition is a virtual function that is specific to the derived class.
     UpdatePosition();
@@ -187,6 +268,7 @@ __forceinline void GameObject::Position(DirectX::XMFLOAT3 position)
 __forceinline void GameObject::Position(DirectX::XMVECTOR position)
 {
     XMStoreFloat3(&m_position, position);
+    m_positionVersion++;
     // Update any internal states that are dependent on the position.
     // UpdatePosition is a virtual function that is specific to the derived class.
     UpdatePosition();
@@ -257,6 +339,11 @@ __forceinline void GameObject::Mesh(_In_ MeshObject^ mesh)
     m_mesh = mesh;
 }
 
+__forceinline MeshObject^ GameObject::Mesh()
+{
+    return m_mesh;
+}
+
 __forceinline void GameObject::HitSound(_In_ SoundEffect^ hitSound)
 {
     m_hitSound = hitSound;
@@ -0,0 +1,322 @@
+//********************************************************* 
+// 
+// Copyright (c) Microsoft. All rights reserved. 
+// This code is licensed under the MIT License (MIT). 
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF 
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY 
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR 
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT. 
+// 
+//*********************************************************
+
+#include "pch.h"
+#include "GameObjectStore.h"
+#include "ConstantBuffers.h"
+#include "GameConstants.h"
+
+using namespace DirectX;
+
+//----------------------------------------------------------------------
+
+GameObjectStore::GameObjectStore() :
+    m_freeSlot(NoSlot)
+{
+}
+
+//----------------------------------------------------------------------
+
+GameObjectHandle GameObjectStore::Create()
+{
+    unsigned int slot = m_freeSlot;
+    if (slot == NoSlot)
+    {
+        Slot newSlot = { 0, 0 };
+        m_slots.push_back(newSlot);
+        slot = static_cast<unsigned int>(m_slots.size() - 1);
+    }
+    else
+    {
+        m_freeSlot = m_slots[slot].index;
+    }
+    m_slots[slot].index = Count();
+    m_denseSlots.push_back(slot);
+
+    XMFLOAT4X4 identity;
+    XMStoreFloat4x4(&identity, XMMatrixIdentity());
+    GameObjectRender render = { nullptr, nullptr, nullptr };
+
+    m_positions.push_back(XMFLOAT3(0.0f, 0.0f, 0.0f));
+    m_velocities.push_back(XMFLOAT3(0.0f, 0.0f, 0.0f));
+    m_flags.push_back(GameObjectFlags::OnGround);
+    m_targetIds.push_back(0);
+    m_hitTimes.push_back(0.0f);
+    m_shapeMatrices.push_back(identity);
+    m_modelMatrices.push_back(identity);
+    m_render.push_back(render);
+    m_hitSounds.push_back(nullptr);
+    m_animations.push_back(nullptr);
+
+    GameObjectHandle handle = { slot, m_slots[slot].generation };
+    return handle;
+}
+
+//----------------------------------------------------------------------
+
+GameObjectHandle GameObjectStore::Import(_In_ GameObject^ object)
+{
+    GameObjectHandle handle = Create();
+    unsigned int index = Index(handle);
+
+    m_positions[index] = object->Position();
+    m_velocities[index] = object->Velocity();
+    m_flags[index] = static_cast<unsigned char>(
+        (object->Active() ? GameObjectFlags::Active : 0) |
+        (object->Target() ? GameObjectFlags::Target : 0) |
+        (object->Hit() ? GameObjectFlags::Hit : 0) |
+        (object->OnGround() ? GameObjectFlags::OnGround : 0)
+        );
+    m_targetIds[index] = object->TargetId();
+    m_hitTimes[index] = object->HitTime();
+
+    // Every shape builds its model matrix as scale * rotation * translation, so dropping the
+    // translation row leaves the part that does not change when the object moves.
+    XMStoreFloat4x4(&m_modelMatrices[index], object->ModelMatrix());
+    m_shapeMatrices[index] = m_modelMatrices[index];
+    m_shapeMatrices[index]._41 = 0.0f;
+    m_shapeMatrices[index]._42 = 0.0f;
+    m_shapeMatrices[index]._43 = 0.0f;
+
+    m_render[index].mesh = object->Mesh();
+    m_render[index].normalMaterial = object->NormalMaterial();
+    m_render[index].hitMaterial = object->HitMaterial();
+    m_hitSounds[index] = object->HitSound();
+    m_animations[index] = object->AnimatePosition();
+    return handle;
+}
+
+//----------------------------------------------------------------------
+
+void GameObjectStore::WriteBack(GameObjectHandle handle, _In_ GameObject^ object)
+{
+    unsigned int index = Index(handle);
+    unsigned char flags = m_flags[index];
+
+    object->Position(m_positions[index]);
+    object->Velocity(m_velocities[index]);
+    object->Active((flags & GameObjectFlags::Active) != 0);
+    object->Target((flags & GameObjectFlags::Target) != 0);
+    object->Hit((flags & GameObjectFlags::Hit) != 0);
+    object->OnGround((flags & GameObjectFlags::OnGround) != 0);
+    object->TargetId(m_targetIds[index]);
+    object->HitTime(m_hitTimes[index]);
+}
+
+//----------------------------------------------------------------------
+
+void GameObjectStore::Destroy(GameObjectHandle handle)
+{
+    if (!IsValid(handle))
+    {
+        return;
+    }
+
+    // Move the last object into the hole so that the arrays stay packed.
+    unsigned int index = m_slots[handle.slot].index;
+    unsigned int last = Count() - 1;
+    if (index != last)
+    {
+        m_positions[index] = m_positions[last];
+        m_velocities[index] = m_velocities[last];
+        m_flags[index] = m_flags[last];
+        m_targetIds[index] = m_targetIds[last];
+        m_hitTimes[index] = m_hitTimes[last];
+        m_shapeMatrices[index] = m_shapeMatrices[last];
+        m_modelMatrices[index] = m_modelMatrices[last];
+        m_render[index] = m_render[last];
+        m_hitSounds[index] = m_hitSounds[last];
+        m_animations[index] = m_animations[last];
+        m_denseSlots[index] = m_denseSlots[last];
+        m_slots[m_denseSlots[index]].index = index;
+    }
+
+    m_positions.pop_back();
+    m_velocities.pop_back();
+    m_flags.pop_back();
+    m_targetIds.pop_back();
+    m_hitTimes.pop_back();
+    m_shapeMatrices.pop_back();
+    m_modelMatrices.pop_back();
+    m_render.pop_back();
+    m_hitSounds.pop_back();
+    m_animations.pop_back();
+    m_denseSlots.pop_back();
+
+    m_slots[handle.slot].generation++;
+    m_slots[handle.slot].index = m_freeSlot;
+    m_freeSlot = handle.slot;
+}
+
+//----------------------------------------------------------------------
+
+void GameObjectStore::Clear()
+{
+    // Keep the slots so that handles from before the Clear are recognized as stale.
+    for (auto slot = m_denseSlots.begin(); slot != m_denseSlots.end(); slot++)
+    {
+        m_slots[*slot].generation++;
+        m_slots[*slot].index = m_freeSlot;
+        m_freeSlot = *slot;
+    }
+
+    m_positions.clear();
+    m_velocities.clear();
+    m_flags.clear();
+    m_targetIds.clear();
+    m_hitTimes.clear();
+    m_shapeMatrices.clear();
+    m_modelMatrices.clear();
+    m_render.clear();
+    m_hitSounds.clear();
+    m_animations.clear();
+    m_denseSlots.clear();
+}
+
+//----------------------------------------------------------------------
+
+void GameObjectStore::Integrate(float timeDelta)
+{
+    IntegrateRange(0, Count(), timeDelta);
+}
+
+//----------------------------------------------------------------------
+
+void GameObjectStore::Integrate(float timeDelta, JobSystem& jobs)
+{
+    jobs.ParallelFor(0, Count(), JobGrain, [this, timeDelta](unsigned int first, unsigned int last)
+    {
+        IntegrateRange(first, last, timeDelta);
+    });
+}
+
+//----------------------------------------------------------------------
+
+void GameObjectStore::IntegrateRange(unsigned int first, unsigned int last, float timeDelta)
+{
+    const unsigned char moving = GameObjectFlags::Active | GameObjectFlags::Dynamic;
+    const float gravityStep = GameConstants::Physics::Gravity * timeDelta;
+
+    XMFLOAT3* position = m_positions.data();
+    XMFLOAT3* velocity = m_velocities.data();
+    unsigned char const* flags = m_flags.data();
+    for (unsigned int i = first; i < last; i++)
+    {
+        if ((flags[i] & (moving | GameObjectFlags::OnGround)) == moving)
+        {
+            velocity[i].y -= gravityStep;
+            position[i].x += velocity[i].x * timeDelta;
+            position[i].y += velocity[i].y * timeDelta;
+            position[i].z += velocity[i].z * timeDelta;
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+
+void GameObjectStore::AnimatePositions(float t)
+{
+    AnimateRange(0, Count(), t);
+}
+
+//----------------------------------------------------------------------
+
+void GameObjectStore::AnimatePositions(float t, JobSystem& jobs)
+{
+    jobs.ParallelFor(0, Count(), JobGrain, [this, t](unsigned int first, unsigned int last)
+    {
+        AnimateRange(first, last, t);
+    });
+}
+
+//----------------------------------------------------------------------
+
+void GameObjectStore::AnimateRange(unsigned int first, unsigned int last, float t)
+{
+    for (unsigned int i = first; i < last; i++)
+    {
+        Animate^ animation = m_animations[i];
+        if (animation != nullptr && animation->IsActive(t))
+        {
+            m_positions[i] = animation->Evaluate(t);
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+
+void GameObjectStore::UpdateTransforms()
+{
+    TransformRange(0, Count());
+}
+
+//----------------------------------------------------------------------
+
+void GameObjectStore::UpdateTransforms(JobSystem& jobs)
+{
+    jobs.ParallelFor(0, Count(), JobGrain, [this](unsigned int first, unsigned int last)
+    {
+        TransformRange(first, last);
+    });
+}
+
+//----------------------------------------------------------------------
+
+void GameObjectStore::TransformRange(unsigned int first, unsigned int last)
+{
+    for (unsigned int i = first; i < last; i++)
+    {
+        XMStoreFloat4x4(
+            &m_modelMatrices[i],
+            XMLoadFloat4x4(&m_shapeMatrices[i]) *
+            XMMatrixTranslation(m_positions[i].x, m_positions[i].y, m_positions[i].z)
+            );
+    }
+}
+
+//----------------------------------------------------------------------
+
+void GameObjectStore::Render(
+    _In_ ID3D11DeviceContext *context,
+    _In_ ID3D11Buffer *primitiveConstantBuffer
+    )
+{
+    unsigned int count = Count();
+    for (unsigned int i = 0; i < count; i++)
+    {
+        GameObjectRender& render = m_render[i];
+        if (!(m_flags[i] & GameObjectFlags::Active) || (render.mesh == nullptr) || (render.normalMaterial == nullptr))
+        {
+            continue;
+        }
+
+        ConstantBufferChangesEveryPrim constantBuffer;
+
+        XMStoreFloat4x4(
+            &constantBuffer.worldMatrix,
+            XMMatrixTranspose(XMLoadFloat4x4(&m_modelMatrices[i]))
+            );
+
+        if ((m_flags[i] & GameObjectFlags::Hit) && render.hitMaterial != nullptr)
+        {
+            render.hitMaterial->RenderSetup(context, &constantBuffer);
+        }
+        else
+        {
+            render.normalMaterial->RenderSetup(context, &constantBuffer);
+        }
+        context->UpdateSubresource(primitiveConstantBuffer, 0, nullptr, &constantBuffer, 0, 0);
+
+        render.mesh->Render(context);
+    }
+}
+
+//----------------------------------------------------------------------
@@ -0,0 +1,211 @@
+//********************************************************* 
+// 
+// Copyright (c) Microsoft. All rights reserved. 
+// This code is licensed under the MIT License (MIT). 
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF 
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY 
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR 
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT. 
+// 
+//*********************************************************
+
+#pragma once
+
+// GameObjectStore:
+// This class keeps the state of many game objects as parallel arrays instead of one heap
+// object per game object.  The simulation state (position, velocity and flags) is packed
+// in its own arrays, so the physics and animation passes read it sequentially.  The
+// transform, render and audio components are kept in separate arrays so that those
+// passes don't drag the other data through the cache.
+//
+// Objects are packed: destroying one moves the last object into its place.  Code that
+// needs to refer to an object over time keeps a GameObjectHandle, which is a slot and a
+// generation.  A handle stays valid until its object is destroyed, and a stale handle is
+// detected rather than reaching the object that reused its slot.  Dense indices are
+// valid only until the next Destroy.
+//
+// Import copies an existing GameObject into the store and WriteBack copies the
+// simulation state back, so levels can move over one pass at a time.
+//
+// The per-object passes also come in a form that spreads the objects over a JobSystem;
+// each object is only touched by the chunk that contains it.
+
+#include "GameObject.h"
+#include "JobSystem.h"
+
+struct GameObjectHandle
+{
+    unsigned int slot;
+    unsigned int generation;
+};
+
+namespace GameObjectFlags
+{
+    static const unsigned char Active   = 0x01;
+    static const unsigned char Target   = 0x02;
+    static const unsigned char Hit      = 0x04;
+    static const unsigned char OnGround = 0x08;
+    static const unsigned char Dynamic  = 0x10;     // Moved by Integrate, e.g. ammo.
+};
+
+struct GameObjectRender
+{
+    MeshObject^ mesh;
+    Material^   normalMaterial;
+    Material^   hitMaterial;
+};
+
+ref class GameObjectStore
+{
+internal:
+    GameObjectStore();
+
+    GameObjectHandle Create();
+    GameObjectHandle Import(_In_ GameObject^ object);
+    void WriteBack(GameObjectHandle handle, _In_ GameObject^ object);
+    void Destroy(GameObjectHandle handle);
+    void Clear();
+
+    bool IsValid(GameObjectHandle handle);
+    unsigned int Count();
+    unsigned int Index(GameObjectHandle handle);
+    GameObjectHandle Handle(unsigned int index);
+
+    // Component arrays, Count() elements each.
+    DirectX::XMFLOAT3*   Positions();
+    DirectX::XMFLOAT3*   Velocities();
+    unsigned char*       Flags();
+    int*                 TargetIds();
+    float*               HitTimes();
+    DirectX::XMFLOAT4X4* ShapeMatrices();       // Scale and rotation; the model matrix without the translation.
+    DirectX::XMFLOAT4X4* ModelMatrices();
+    GameObjectRender*    RenderComponents();
+    SoundEffect^*        HitSounds();
+    Animate^*            Animations();
+
+    // Moves every active, dynamic object that is not resting on the ground.
+    void Integrate(float timeDelta);
+    void Integrate(float timeDelta, JobSystem& jobs);
+
+    // Sets the position of every object whose animation is active at time t.
+    void AnimatePositions(float t);
+    void AnimatePositions(float t, JobSystem& jobs);
+
+    // Rebuilds the model matrices from the shape matrices and positions.
+    void UpdateTransforms();
+    void UpdateTransforms(JobSystem& jobs);
+
+    void Render(
+        _In_ ID3D11DeviceContext *context,
+        _In_ ID3D11Buffer *primitiveConstantBuffer
+        );
+
+private:
+    struct Slot
+    {
+        unsigned int index;             // Dense index while the slot is in use, next free slot otherwise.
+        unsigned int generation;
+    };
+
+    static const unsigned int NoSlot = 0xFFFFFFFF;
+    static const unsigned int JobGrain = 256;      // Objects per job in the parallel passes.
+
+    void IntegrateRange(unsigned int first, unsigned int last, float timeDelta);
+    void AnimateRange(unsigned int first, unsigned int last, float t);
+    void TransformRange(unsigned int first, unsigned int last);
+
+    // Simulation state.
+    std::vector<DirectX::XMFLOAT3>      m_positions;
+    std::vector<DirectX::XMFLOAT3>      m_velocities;
+    std::vector<unsigned char>          m_flags;
+    std::vector<int>                    m_targetIds;
+    std::vector<float>                  m_hitTimes;
+
+    // Transform components.
+    std::vector<DirectX::XMFLOAT4X4>    m_shapeMatrices;
+    std::vector<DirectX::XMFLOAT4X4>    m_modelMatrices;
+
+    // Render, audio and animation components.
+    std::vector<GameObjectRender>       m_render;
+    std::vector<SoundEffect^>           m_hitSounds;
+    std::vector<Animate^>               m_animations;
+
+    // Handle bookkeeping.
+    std::vector<unsigned int>           m_denseSlots;   // Slot of each dense index.
+    std::vector<Slot>                   m_slots;
+    unsigned int                        m_freeSlot;
+};
+
+__forceinline bool GameObjectStore::IsValid(GameObjectHandle handle)
+{
+    return handle.slot < m_slots.size() &&
+        m_slots[handle.slot].generation == handle.generation &&
+        m_slots[handle.slot].index < m_denseSlots.size() &&
+        m_denseSlots[m_slots[handle.slot].index] == handle.slot;
+}
+
+__forceinline unsigned int GameObjectStore::Count()
+{
+    return static_cast<unsigned int>(m_positions.size());
+}
+
+__forceinline unsigned int GameObjectStore::Index(GameObjectHandle handle)
+{
+    return m_slots[handle.slot].index;
+}
+
+__forceinline GameObjectHandle GameObjectStore::Handle(unsigned int index)
+{
+    GameObjectHandle handle = { m_denseSlots[index], m_slots[m_denseSlots[index]].generation };
+    return handle;
+}
+
+__forceinline DirectX::XMFLOAT3* GameObjectStore::Positions()
+{
+    return m_positions.data();
+}
+
+__forceinline DirectX::XMFLOAT3* GameObjectStore::Velocities()
+{
+    return m_velocities.data();
+}
+
+__forceinline unsigned char* GameObjectStore::Flags()
+{
+    return m_flags.data();
+}
+
+__forceinline int* GameObjectStore::TargetIds()
+{
+    return m_targetIds.data();
+}
+
+__forceinline float* GameObjectStore::HitTimes()
+{
+    return m_hitTimes.data();
+}
+
+__forceinline DirectX::XMFLOAT4X4* GameObjectStore::ShapeMatrices()
+{
+    return m_shapeMatrices.data();
+}
+
+__forceinline DirectX::XMFLOAT4X4* GameObjectStore::ModelMatrices()
+{
+    return m_modelMatrices.data();
+}
+
+__forceinline GameObjectRender* GameObjectStore::RenderComponents()
+{
+    return m_render.data();
+}
+
+__forceinline SoundEffect^* GameObjectStore::HitSounds()
+{
+    return m_hitSounds.data();
+}
+
+__forceinline Animate^* GameObjectStore::Animations()
+{
+    return m_animations.data();
+}
@@ -0,0 +1,285 @@
+//********************************************************* 
+// 
+// Copyright (c) Microsoft. All rights reserved. 
+// This code is licensed under the MIT License (MIT). 
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF 
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY 
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR 
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT. 
+// 
+//*********************************************************
+
+// Deliberately not using pch.h, which pulls in the Windows and DirectX headers; build
+// this file without the precompiled header.
+#include "InputLog.h"
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    const uint8_t Magic[4] = { 'M', 'L', 'C', 'R' };
+    const uint16_t Version = 1;
+    const size_t HeaderSize = 16;           // Magic, version, reserved, frame count, checksum.
+
+    // Bits of a frame's leading byte.
+    const uint8_t ChangedVelocity   = 0x01;
+    const uint8_t ChangedPitch      = 0x02;
+    const uint8_t ChangedYaw        = 0x04;
+    const uint8_t ChangedFrameTime  = 0x08;
+    const uint8_t Firing            = 0x10;
+    const uint8_t PauseRequested    = 0x20;
+    const uint8_t PressComplete     = 0x40;
+    const uint8_t Reserved          = 0x80;
+
+    inline uint32_t Bits(float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    inline float FromBits(uint32_t bits)
+    {
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    inline void PutUInt32(std::vector<uint8_t>& bytes, uint32_t value)
+    {
+        bytes.push_back(static_cast<uint8_t>(value));
+        bytes.push_back(static_cast<uint8_t>(value >> 8));
+        bytes.push_back(static_cast<uint8_t>(value >> 16));
+        bytes.push_back(static_cast<uint8_t>(value >> 24));
+    }
+
+    inline uint32_t GetUInt32(uint8_t const* bytes)
+    {
+        return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+    }
+
+    // FNV-1a, to catch a damaged file that still parses.
+    uint32_t Checksum(std::vector<uint8_t> const& bytes)
+    {
+        uint32_t hash = 2166136261u;
+        for (auto byte = bytes.begin(); byte != bytes.end(); byte++)
+        {
+            hash = (hash ^ *byte) * 16777619u;
+        }
+        return hash;
+    }
+
+    // Compares bit patterns, so that -0.0 and NaN payloads survive the round trip.
+    inline bool Same(float left, float right)
+    {
+        return Bits(left) == Bits(right);
+    }
+
+    inline FILE* OpenFile(char const* path, char const* mode)
+    {
+#ifdef _MSC_VER
+        FILE* file = nullptr;
+        return (fopen_s(&file, path, mode) == 0) ? file : nullptr;
+#else
+        return fopen(path, mode);
+#endif
+    }
+
+    const InputFrame InitialFrame = { { 0.0f, 0.0f, 0.0f }, 0.0f, 0.0f, 0.0f, false, false, false };
+}
+
+//----------------------------------------------------------------------
+
+InputLog::InputLog()
+{
+    Reset();
+}
+
+//----------------------------------------------------------------------
+
+void InputLog::Reset()
+{
+    m_bytes.clear();
+    m_frameCount = 0;
+    m_last = InitialFrame;
+    Rewind();
+}
+
+//----------------------------------------------------------------------
+
+void InputLog::Append(InputFrame const& frame)
+{
+    size_t start = m_bytes.size();
+    m_bytes.push_back(0);
+
+    uint8_t flags = 0;
+    if (!Same(frame.velocity[0], m_last.velocity[0]) ||
+        !Same(frame.velocity[1], m_last.velocity[1]) ||
+        !Same(frame.velocity[2], m_last.velocity[2]))
+    {
+        flags |= ChangedVelocity;
+        PutUInt32(m_bytes, Bits(frame.velocity[0]));
+        PutUInt32(m_bytes, Bits(frame.velocity[1]));
+        PutUInt32(m_bytes, Bits(frame.velocity[2]));
+    }
+    if (!Same(frame.pitch, m_last.pitch))
+    {
+        flags |= ChangedPitch;
+        PutUInt32(m_bytes, Bits(frame.pitch));
+    }
+    if (!Same(frame.yaw, m_last.yaw))
+    {
+        flags |= ChangedYaw;
+        PutUInt32(m_bytes, Bits(frame.yaw));
+    }
+    if (!Same(frame.frameTime, m_last.frameTime))
+    {
+        flags |= ChangedFrameTime;
+        PutUInt32(m_bytes, Bits(frame.frameTime));
+    }
+    flags |= frame.firing ? Firing : 0;
+    flags |= frame.pauseRequested ? PauseRequested : 0;
+    flags |= frame.pressComplete ? PressComplete : 0;
+
+    m_bytes[start] = flags;
+    m_last = frame;
+    m_frameCount++;
+}
+
+//----------------------------------------------------------------------
+
+void InputLog::Rewind()
+{
+    m_readOffset = 0;
+    m_readLast = InitialFrame;
+}
+
+//----------------------------------------------------------------------
+
+bool InputLog::Next(InputFrame* frame)
+{
+    if (m_readOffset >= m_bytes.size())
+    {
+        return false;
+    }
+
+    uint8_t flags = m_bytes[m_readOffset];
+    size_t size = 1 +
+        ((flags & ChangedVelocity) ? 12 : 0) +
+        ((flags & ChangedPitch) ? 4 : 0) +
+        ((flags & ChangedYaw) ? 4 : 0) +
+        ((flags & ChangedFrameTime) ? 4 : 0);
+    if ((flags & Reserved) || size > m_bytes.size() - m_readOffset)
+    {
+        return false;
+    }
+
+    InputFrame next = m_readLast;
+    uint8_t const* field = m_bytes.data() + m_readOffset + 1;
+    if (flags & ChangedVelocity)
+    {
+        next.velocity[0] = FromBits(GetUInt32(field));
+        next.velocity[1] = FromBits(GetUInt32(field + 4));
+        next.velocity[2] = FromBits(GetUInt32(field + 8));
+        field += 12;
+    }
+    if (flags & ChangedPitch)
+    {
+        next.pitch = FromBits(GetUInt32(field));
+        field += 4;
+    }
+    if (flags & ChangedYaw)
+    {
+        next.yaw = FromBits(GetUInt32(field));
+        field += 4;
+    }
+    if (flags & ChangedFrameTime)
+    {
+        next.frameTime = FromBits(GetUInt32(field));
+    }
+    next.firing = (flags & Firing) != 0;
+    next.pauseRequested = (flags & PauseRequested) != 0;
+    next.pressComplete = (flags & PressComplete) != 0;
+
+    m_readOffset += size;
+    m_readLast = next;
+    *frame = next;
+    return true;
+}
+
+//----------------------------------------------------------------------
+
+bool InputLog::Save(char const* path) const
+{
+    std::vector<uint8_t> header(Magic, Magic + sizeof(Magic));
+    header.push_back(static_cast<uint8_t>(Version));
+    header.push_back(static_cast<uint8_t>(Version >> 8));
+    header.push_back(0);
+    header.push_back(0);
+    PutUInt32(header, m_frameCount);
+    PutUInt32(header, Checksum(m_bytes));
+
+    FILE* file = OpenFile(path, "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    bool written =
+        fwrite(header.data(), 1, header.size(), file) == header.size() &&
+        fwrite(m_bytes.data(), 1, m_bytes.size(), file) == m_bytes.size();
+    return (fclose(file) == 0) && written;
+}
+
+//----------------------------------------------------------------------
+
+bool InputLog::Load(char const* path)
+{
+    Reset();
+
+    FILE* file = OpenFile(path, "rb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    std::vector<uint8_t> contents;
+    uint8_t buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        contents.insert(contents.end(), buffer, buffer + read);
+    }
+    fclose(file);
+
+    if (contents.size() < HeaderSize ||
+        memcmp(contents.data(), Magic, sizeof(Magic)) != 0 ||
+        (contents[4] | (contents[5] << 8)) != Version)
+    {
+        return false;
+    }
+
+    // Walk the frames once so that a truncated or damaged file is refused up front.
+    m_bytes.assign(contents.begin() + HeaderSize, contents.end());
+    uint32_t frameCount = GetUInt32(contents.data() + 8);
+    if (Checksum(m_bytes) != GetUInt32(contents.data() + 12))
+    {
+        Reset();
+        return false;
+    }
+    InputFrame frame;
+    uint32_t frames = 0;
+    while (Next(&frame))
+    {
+        m_last = frame;
+        frames++;
+    }
+    if (frames != frameCount || m_readOffset != m_bytes.size())
+    {
+        Reset();
+        return false;
+    }
+    m_frameCount = frameCount;
+    Rewind();
+    return true;
+}
+
+//----------------------------------------------------------------------
@@ -0,0 +1,73 @@
+//********************************************************* 
+// 
+// Copyright (c) Microsoft. All rights reserved. 
+// This code is licensed under the MIT License (MIT). 
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF 
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY 
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR 
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT. 
+// 
+//*********************************************************
+
+#pragma once
+
+// InputLog:
+// A compact binary recording of what the MoveLookController reported to the game on
+// each frame, so that a session can be replayed exactly: for benchmarks, for regression
+// tests of the simulation, and for reproducing bugs.  A frame holds the velocity, pitch
+// and yaw the controller computed in Update, the frame time the game loop used, and
+// which of the edge queries (IsFiring, IsPauseRequested, IsPressComplete) returned true.
+//
+// Each frame is stored as one byte that says which values differ from the previous
+// frame and which queries fired, followed by only the values that changed, as the raw
+// bits of the floats.  A frame in which nothing changed takes a single byte, and replayed
+// values are bit for bit the recorded ones.  All multi-byte values are little endian.
+//
+// InputLog.h and InputLog.cpp use only the C++ standard library, without SAL annotations
+// or the precompiled header, so that logs can be produced and read by tools on any
+// platform.  In a project that uses pch.h, set InputLog.cpp to not use precompiled headers.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct InputFrame
+{
+    float velocity[3];
+    float pitch;
+    float yaw;
+    float frameTime;
+    bool  firing;
+    bool  pauseRequested;
+    bool  pressComplete;
+};
+
+class InputLog
+{
+public:
+    InputLog();
+
+    void Append(InputFrame const& frame);
+
+    // Replay cursor.  Next returns false at the end of the log or at a damaged frame.
+    void Rewind();
+    bool Next(InputFrame* frame);
+
+    uint32_t FrameCount() const { return m_frameCount; }
+    std::vector<uint8_t> const& Bytes() const { return m_bytes; }
+
+    // Save writes a header with a checksum followed by the frames.  Load returns false,
+    // leaving the log empty, when the file can't be read, isn't an input log of this
+    // version or is damaged.
+    bool Save(char const* path) const;
+    bool Load(char const* path);
+
+private:
+    void Reset();
+
+    std::vector<uint8_t> m_bytes;           // Frames only; Save prepends the header.
+    uint32_t             m_frameCount;
+    InputFrame           m_last;            // Last frame appended.
+    size_t               m_readOffset;
+    InputFrame           m_readLast;        // Last frame returned by Next.
+};
@@ -0,0 +1,428 @@
+//********************************************************* 
+// 
+// Copyright (c) Microsoft. All rights reserved. 
+// This code is licensed under the MIT License (MIT). 
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF 
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY 
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR 
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT. 
+// 
+//*********************************************************
+
+#include "pch.h"
+#include "JobSystem.h"
+
+namespace
+{
+    struct Range
+    {
+        std::function<void(unsigned int, unsigned int)> const* body;
+        unsigned int                                           begin;
+        unsigned int                                           end;
+        unsigned int                                           grain;
+        std::atomic<unsigned int>                              remaining;
+    };
+
+    // The queue of the running thread, valid while t_system is the system that owns it.
+    thread_local JobSystem const* t_system = nullptr;
+    thread_local unsigned int     t_queue = 0;
+
+    LARGE_INTEGER Now()
+    {
+        LARGE_INTEGER time;
+        if (!QueryPerformanceCounter(&time))
+        {
+            throw ref new Platform::FailureException();
+        }
+        return time;
+    }
+}
+
+//----------------------------------------------------------------------
+
+JobGraph::JobGraph() :
+    m_system(nullptr),
+    m_remaining(0)
+{
+    LARGE_INTEGER frequency;
+    if (!QueryPerformanceFrequency(&frequency))
+    {
+        throw ref new Platform::FailureException();
+    }
+    m_secondsPerCount = 1.0f / static_cast<float>(frequency.QuadPart);
+    m_runTime.QuadPart = 0;
+}
+
+//----------------------------------------------------------------------
+
+unsigned int JobGraph::Add(
+    _In_z_ char const* name,
+    std::function<void()> const& work
+    )
+{
+    m_nodes.emplace_back();
+    Node& node = m_nodes.back();
+    node.name = name;
+    node.work = work;
+    node.dependencies = 0;
+    node.pending = 0;
+    node.thread = -1;
+    node.startTime.QuadPart = 0;
+    node.endTime.QuadPart = 0;
+    return static_cast<unsigned int>(m_nodes.size() - 1);
+}
+
+//----------------------------------------------------------------------
+
+void JobGraph::Precede(unsigned int before, unsigned int after)
+{
+    if (before >= m_nodes.size() || after >= m_nodes.size())
+    {
+        throw ref new Platform::InvalidArgumentException();
+    }
+    m_nodes[before].successors.push_back(after);
+    m_nodes[after].dependencies++;
+}
+
+//----------------------------------------------------------------------
+
+unsigned int JobGraph::Count()
+{
+    return static_cast<unsigned int>(m_nodes.size());
+}
+
+//----------------------------------------------------------------------
+
+void JobGraph::Clear()
+{
+    m_nodes.clear();
+}
+
+//----------------------------------------------------------------------
+
+std::string JobGraph::Describe()
+{
+    std::vector<std::vector<unsigned int>> predecessors(m_nodes.size());
+    for (unsigned int i = 0; i < m_nodes.size(); i++)
+    {
+        for (auto successor = m_nodes[i].successors.begin(); successor != m_nodes[i].successors.end(); successor++)
+        {
+            predecessors[*successor].push_back(i);
+        }
+    }
+
+    std::string description;
+    char line[128];
+    for (unsigned int i = 0; i < m_nodes.size(); i++)
+    {
+        Node& node = m_nodes[i];
+        sprintf_s(line, sizeof(line) / sizeof(line[0]), "%3u %s", i, node.name.c_str());
+        description += line;
+        if (!predecessors[i].empty())
+        {
+            description += " after";
+            for (auto predecessor = predecessors[i].begin(); predecessor != predecessors[i].end(); predecessor++)
+            {
+                sprintf_s(line, sizeof(line) / sizeof(line[0]), " %u", *predecessor);
+                description += line;
+            }
+        }
+        if (node.thread >= 0)
+        {
+            sprintf_s(
+                line,
+                sizeof(line) / sizeof(line[0]),
+                " on thread %d at %.3f ms for %.3f ms",
+                node.thread,
+                (node.startTime.QuadPart - m_runTime.QuadPart) * m_secondsPerCount * 1000.0f,
+                (node.endTime.QuadPart - node.startTime.QuadPart) * m_secondsPerCount * 1000.0f
+                );
+            description += line;
+        }
+        description += "\n";
+    }
+    return description;
+}
+
+//----------------------------------------------------------------------
+
+JobSystem::JobSystem(unsigned int workerCount) :
+    m_queued(0),
+    m_stopping(false)
+{
+    if (workerCount == 0)
+    {
+        unsigned int cores = std::thread::hardware_concurrency();
+        workerCount = (cores > 1) ? cores - 1 : 0;
+    }
+
+    for (unsigned int i = 0; i <= workerCount; i++)
+    {
+        m_queues.push_back(std::unique_ptr<Queue>(new Queue()));
+    }
+    for (unsigned int i = 1; i <= workerCount; i++)
+    {
+        m_workers.push_back(std::thread(&JobSystem::WorkerLoop, this, i));
+    }
+}
+
+//----------------------------------------------------------------------
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepLock);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto worker = m_workers.begin(); worker != m_workers.end(); worker++)
+    {
+        worker->join();
+    }
+}
+
+//----------------------------------------------------------------------
+
+unsigned int JobSystem::ThreadCount()
+{
+    return static_cast<unsigned int>(m_queues.size());
+}
+
+//----------------------------------------------------------------------
+
+void JobSystem::ParallelFor(
+    unsigned int begin,
+    unsigned int end,
+    unsigned int grain,
+    std::function<void(unsigned int first, unsigned int last)> const& body
+    )
+{
+    if (begin >= end)
+    {
+        return;
+    }
+    grain = max(grain, 1u);
+    unsigned int chunks = (end - begin - 1) / grain + 1;
+    if (chunks == 1 || m_workers.empty())
+    {
+        body(begin, end);
+        return;
+    }
+
+    Range range;
+    range.body = &body;
+    range.begin = begin;
+    range.end = end;
+    range.grain = grain;
+    range.remaining = chunks;
+
+    // Offer every chunk but the first, which this thread starts on right away.
+    for (unsigned int chunk = 1; chunk < chunks; chunk++)
+    {
+        Task task = { &JobSystem::RunRange, &range, chunk };
+        Push(task);
+    }
+    RunRange(&range, 0);
+    WaitFor(range.remaining);
+}
+
+//----------------------------------------------------------------------
+
+void JobSystem::Run(JobGraph& graph)
+{
+    // Check for a cycle before starting anything: every job has to become ready once the
+    // jobs with no dependencies have run.
+    unsigned int count = graph.Count();
+    std::vector<unsigned int> pending(count);
+    std::vector<unsigned int> ready;
+    for (unsigned int i = 0; i < count; i++)
+    {
+        pending[i] = graph.m_nodes[i].dependencies;
+        if (pending[i] == 0)
+        {
+            ready.push_back(i);
+        }
+    }
+    std::vector<unsigned int> roots(ready);
+    for (unsigned int visited = 0; visited < ready.size(); visited++)
+    {
+        std::vector<unsigned int>& successors = graph.m_nodes[ready[visited]].successors;
+        for (auto successor = successors.begin(); successor != successors.end(); successor++)
+        {
+            if (--pending[*successor] == 0)
+            {
+                ready.push_back(*successor);
+            }
+        }
+    }
+    if (ready.size() != count)
+    {
+        throw ref new Platform::InvalidArgumentException();
+    }
+    if (count == 0)
+    {
+        return;
+    }
+
+    graph.m_system = this;
+    graph.m_runTime = Now();
+    for (auto node = graph.m_nodes.begin(); node != graph.m_nodes.end(); node++)
+    {
+        node->pending = node->dependencies;
+        node->thread = -1;
+    }
+    graph.m_remaining = count;
+
+    for (auto root = roots.begin(); root != roots.end(); root++)
+    {
+        Task task = { &JobSystem::RunNode, &graph, *root };
+        Push(task);
+    }
+    WaitFor(graph.m_remaining);
+}
+
+//----------------------------------------------------------------------
+
+void JobSystem::RunRange(void* context, unsigned int index)
+{
+    Range* range = static_cast<Range*>(context);
+    unsigned int first = range->begin + index * range->grain;
+    unsigned int last = (range->end - first > range->grain) ? first + range->grain : range->end;
+    (*range->body)(first, last);
+    range->remaining.fetch_sub(1, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------
+
+void JobSystem::RunNode(void* context, unsigned int index)
+{
+    JobGraph* graph = static_cast<JobGraph*>(context);
+    JobGraph::Node& node = graph->m_nodes[index];
+
+    node.thread = static_cast<int>(graph->m_system->CurrentQueue());
+    node.startTime = Now();
+    node.work();
+    node.endTime = Now();
+
+    for (auto successor = node.successors.begin(); successor != node.successors.end(); successor++)
+    {
+        if (graph->m_nodes[*successor].pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            Task task = { &JobSystem::RunNode, graph, *successor };
+            graph->m_system->Push(task);
+        }
+    }
+    graph->m_remaining.fetch_sub(1, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------
+
+unsigned int JobSystem::CurrentQueue()
+{
+    return (t_system == this) ? t_queue : 0;
+}
+
+//----------------------------------------------------------------------
+
+void JobSystem::Push(Task const& task)
+{
+    Queue& queue = *m_queues[CurrentQueue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.lock);
+        queue.tasks.push_back(task);
+    }
+    m_queued.fetch_add(1, std::memory_order_release);
+
+    // Taking the lock orders the count above against a worker that is about to sleep.
+    {
+        std::lock_guard<std::mutex> lock(m_sleepLock);
+    }
+    m_wake.notify_one();
+}
+
+//----------------------------------------------------------------------
+
+bool JobSystem::Pop(unsigned int queue, _Out_ Task* task)
+{
+    Queue& own = *m_queues[queue];
+    std::lock_guard<std::mutex> lock(own.lock);
+    if (own.tasks.empty())
+    {
+        return false;
+    }
+    *task = own.tasks.back();
+    own.tasks.pop_back();
+    m_queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+//----------------------------------------------------------------------
+
+bool JobSystem::Steal(unsigned int thief, _Out_ Task* task)
+{
+    unsigned int count = static_cast<unsigned int>(m_queues.size());
+    for (unsigned int i = 1; i < count; i++)
+    {
+        Queue& victim = *m_queues[(thief + i) % count];
+        std::lock_guard<std::mutex> lock(victim.lock);
+        if (!victim.tasks.empty())
+        {
+            *task = victim.tasks.front();
+            victim.tasks.pop_front();
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+//----------------------------------------------------------------------
+
+bool JobSystem::TryRunOne(unsigned int queue)
+{
+    Task task;
+    if (!Pop(queue, &task) && !Steal(queue, &task))
+    {
+        return false;
+    }
+    task.run(task.context, task.index);
+    return true;
+}
+
+//----------------------------------------------------------------------
+
+void JobSystem::WaitFor(std::atomic<unsigned int> const& remaining)
+{
+    unsigned int queue = CurrentQueue();
+    while (remaining.load(std::memory_order_acquire) != 0)
+    {
+        if (!TryRunOne(queue))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+
+void JobSystem::WorkerLoop(unsigned int queue)
+{
+    t_system = this;
+    t_queue = queue;
+    for (;;)
+    {
+        if (TryRunOne(queue))
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepLock);
+        m_wake.wait(lock, [this]() { return m_stopping || m_queued.load(std::memory_order_acquire) != 0; });
+        if (m_stopping)
+        {
+            return;
+        }
+    }
+}
+
+//----------------------------------------------------------------------
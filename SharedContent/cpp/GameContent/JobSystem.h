@@ -0,0 +1,133 @@
+//********************************************************* 
+// 
+// Copyright (c) Microsoft. All rights reserved. 
+// This code is licensed under the MIT License (MIT). 
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF 
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY 
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR 
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT. 
+// 
+//*********************************************************
+
+#pragma once
+
+// JobSystem:
+// A pool of worker threads, one per extra core, that run small jobs for the frame stages
+// (physics, animation, level update) in parallel.  Each worker has its own deque of jobs:
+// it pushes and pops at the back, so the jobs it spawns run while their data is still in
+// its cache, and when it runs dry it steals from the front of another worker's deque,
+// where the oldest and usually largest pieces of work are.  The thread that calls Run or
+// ParallelFor works on the jobs too until they are done, so nothing is left idle while it
+// waits.
+//
+// ParallelFor splits a range of indices into chunks of 'grain' indices and runs the body
+// on every chunk.  JobGraph describes a frame as named jobs with dependencies: a job starts
+// once every job it depends on has finished.  After Run the graph records which thread
+// ran each job and when, and Describe prints that for debugging.
+//
+// Jobs must not throw.  Run and ParallelFor may be called from one outside thread at a
+// time and from inside jobs.
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class JobSystem;
+
+class JobGraph
+{
+public:
+    JobGraph();
+
+    unsigned int Add(
+        _In_z_ char const* name,
+        std::function<void()> const& work
+        );
+
+    // 'after' starts only once 'before' has finished.
+    void Precede(unsigned int before, unsigned int after);
+
+    unsigned int Count();
+    void Clear();
+
+    // One line per job: its name, the jobs it waits for, and from the last Run the thread
+    // that ran it (0 is the calling thread) with its start and duration in milliseconds.
+    std::string Describe();
+
+private:
+    friend class JobSystem;
+
+    struct Node
+    {
+        std::string                 name;
+        std::function<void()>       work;
+        std::vector<unsigned int>   successors;
+        unsigned int                dependencies;
+        std::atomic<unsigned int>   pending;
+        int                         thread;
+        LARGE_INTEGER               startTime;
+        LARGE_INTEGER               endTime;
+    };
+
+    std::deque<Node>                m_nodes;
+    JobSystem*                      m_system;
+    std::atomic<unsigned int>       m_remaining;
+    LARGE_INTEGER                   m_runTime;
+    float                           m_secondsPerCount;
+};
+
+class JobSystem
+{
+public:
+    // Zero workers means one per core other than the calling thread's.
+    explicit JobSystem(unsigned int workerCount = 0);
+    ~JobSystem();
+
+    unsigned int ThreadCount();     // Workers plus the calling thread.
+
+    void ParallelFor(
+        unsigned int begin,
+        unsigned int end,
+        unsigned int grain,
+        std::function<void(unsigned int first, unsigned int last)> const& body
+        );
+
+    // Throws InvalidArgumentException when the dependencies form a cycle.
+    void Run(JobGraph& graph);
+
+private:
+    struct Task
+    {
+        void         (*run)(void* context, unsigned int index);
+        void*        context;
+        unsigned int index;
+    };
+
+    struct Queue
+    {
+        std::mutex       lock;
+        std::deque<Task> tasks;
+    };
+
+    static void RunRange(void* context, unsigned int index);
+    static void RunNode(void* context, unsigned int index);
+
+    void Push(Task const& task);
+    bool Pop(unsigned int queue, _Out_ Task* task);
+    bool Steal(unsigned int thief, _Out_ Task* task);
+    bool TryRunOne(unsigned int queue);
+    void WaitFor(std::atomic<unsigned int> const& remaining);
+    void WorkerLoop(unsigned int queue);
+    unsigned int CurrentQueue();
+
+    std::vector<std::unique_ptr<Queue>> m_queues;      // 0 belongs to the calling thread.
+    std::vector<std::thread>            m_workers;
+    std::atomic<unsigned int>           m_queued;
+    std::mutex                          m_sleepLock;
+    std::condition_variable             m_wake;
+    bool                                m_stopping;
+};
@@ -11,6 +11,14 @@
 
 #include "pch.h"
 #include "Level.h"
+#include "GameConstants.h"
+
+//----------------------------------------------------------------------
+
+Level::Level() :
+    m_timers(GameConstants::Physics::StepsPerSecond)
+{
+}
 
 //----------------------------------------------------------------------
 
@@ -18,26 +26,18 @@ bool Level::Update(
     float /* time */,
     float /* elapsedTime */,
     float /* timeRemaining*/,
-    std::vector<GameObject^> objects
+    std::vector<GameObject^> const& /* objects */
     )
 {
-    int left = 0;
-
-    for (auto object = objects.begin(); object != objects.end(); object++)
+    m_tracker.TakeHits(m_hits);
+    for (auto object = m_hits.begin(); object != m_hits.end(); object++)
     {
-        if ((*object)->Active() && (*object)->Target())
+        if ((*object)->Active() && (*object)->Target() && (*object)->Hit())
         {
-            if ((*object)->Hit())
-            {
-                (*object)->Active(false);
-            }
-            else
-            {
-                left++;
-            }
+            (*object)->Active(false);
         }
     }
-    return (left == 0);
+    return (m_tracker.TargetsLeft() == 0);
 }
 
 //----------------------------------------------------------------------
@@ -19,29 +19,40 @@
 //         any animations associated with the objects.
 //     Update - this method is called once per time step and is expected to
 //         determine if the level has been completed.  The Level class provides
-//         a 'standard' Update method which checks each object that is a target
-//         and disables any active targets that have been hit.  It returns true
-//         once there are no active targets remaining.
+//         a 'standard' Update method which disables any active targets that have
+//         been hit.  It returns true once there are no active targets remaining.
 //     SaveState - method to save any Level specific state.  Default is defined as
 //         not saving any state.
 //     LoadState - method to restore any Level specific state.  Default is defined
 //         as not restoring any state.
+//
+// Initialize hands the objects to the level's ObjectiveTracker once they are placed.
+// From then on Update works from what the tracker reports (the targets that were hit
+// since the last step, the number of targets left, the object with a given id) rather
+// than by looking at every object on every step.
+//
+// A level that needs something done at a later time, like Level6 clearing a hit, schedules
+// it on m_timers and advances the wheel from its Update.
 
 #include "GameObject.h"
 #include "PersistentState.h"
+#include "ObjectiveTracker.h"
+#include "TimerWheel.h"
 
 ref class Level abstract
 {
 internal:
+    Level();
+
     virtual void Initialize(
-        std::vector<GameObject^> objects
+        std::vector<GameObject^> const& objects
         ) = 0;
 
     virtual bool Update(
         float time,
         float elapsedTime,
         float timeRemaining,
-        std::vector<GameObject^> objects
+        std::vector<GameObject^> const& objects
         );
 
     virtual void SaveState(PersistentState^ state);
@@ -51,6 +62,9 @@ internal:
     float TimeLimit();
 
 protected private:
-    Platform::String^ m_objective;
-    float             m_timeLimit;
+    Platform::String^        m_objective;
+    float                    m_timeLimit;
+    ObjectiveTracker         m_tracker;
+    std::vector<GameObject^> m_hits;        // Scratch space for ObjectiveTracker::TakeHits.
+    TimerWheel               m_timers;      // Keyed on the time passed to Update.
 };
@@ -25,7 +25,7 @@ Level1::Level1()
 
 //----------------------------------------------------------------------
 
-void Level1::Initialize(std::vector<GameObject^> objects)
+void Level1::Initialize(std::vector<GameObject^> const& objects)
 {
     XMFLOAT3 position[] =
     {
@@ -64,6 +64,7 @@ void Level1::Initialize(std::vector<GameObject^> objects)
             (*object)->Active(false);
         }
     }
+    m_tracker.Track(objects);
 }
 
 //----------------------------------------------------------------------
@@ -21,5 +21,5 @@ ref class Level1: public Level
 {
 internal:
     Level1();
-    virtual void Initialize(std::vector<GameObject^> objects) override;
+    virtual void Initialize(std::vector<GameObject^> const& objects) override;
 };
@@ -23,7 +23,7 @@ Level2::Level2()
 
 //----------------------------------------------------------------------
 
-void Level2::Initialize(std::vector<GameObject^> objects)
+void Level2::Initialize(std::vector<GameObject^> const& objects)
 {
     Level1::Initialize(objects);
 
@@ -48,30 +48,25 @@ bool Level2::Update(
     float /* time */,
     float /* elapsedTime */,
     float /* timeRemaining */,
-    std::vector<GameObject^> objects
+    std::vector<GameObject^> const& /* objects */
     )
 {
-    int left = 0;
-    for (auto object = objects.begin(); object != objects.end(); object++)
+    // Only the next target in order can be hit, so there is nothing to look at in the
+    // list of hits; the tracker knows which object is next.
+    m_tracker.TakeHits(m_hits);
+
+    GameObject^ next = m_tracker.Numbered(m_nextId);
+    while (next != nullptr && next->Active() && next->Hit())
     {
-        if ((*object)->Active() && ((*object)->TargetId() > 0))
-        {
-            if ((*object)->Hit()  && ((*object)->TargetId() == m_nextId))
-            {
-                (*object)->Active(false);
-                m_nextId++;
-            }
-            else
-            {
-                left++;
-            }
-        }
-        if ((*object)->Active() && ((*object)->TargetId() == m_nextId))
-        {
-            (*object)->Target(true);
-        }
+        next->Active(false);
+        m_nextId++;
+        next = m_tracker.Numbered(m_nextId);
+    }
+    if (next != nullptr && next->Active())
+    {
+        next->Target(true);
     }
-    return (left == 0);
+    return (m_tracker.NumberedLeft() == 0);
 }
 
 //----------------------------------------------------------------------
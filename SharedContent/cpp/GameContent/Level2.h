@@ -21,13 +21,13 @@ ref class Level2: public Level1
 {
 internal:
     Level2();
-    virtual void Initialize(std::vector<GameObject^> objects) override;
+    virtual void Initialize(std::vector<GameObject^> const& objects) override;
 
     virtual bool Update(
         float time,
         float elapsedTime,
         float timeRemaining,
-        std::vector<GameObject^> objects
+        std::vector<GameObject^> const& objects
         ) override;
 
     virtual void SaveState(PersistentState^ state) override;
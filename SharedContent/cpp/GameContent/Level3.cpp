@@ -26,7 +26,7 @@ Level3::Level3()
 
 //----------------------------------------------------------------------
 
-void Level3::Initialize(std::vector<GameObject^> objects)
+void Level3::Initialize(std::vector<GameObject^> const& objects)
 {
     XMFLOAT3 position[] =
     {
@@ -171,6 +171,7 @@ void Level3::Initialize(std::vector<GameObject^> objects)
             (*object)->Active(false);
         }
     }
+    m_tracker.Track(objects);
 }
 
 //----------------------------------------------------------------------
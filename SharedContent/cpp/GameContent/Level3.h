@@ -22,5 +22,5 @@ ref class Level3: public Level
 {
 internal:
     Level3();
-    virtual void Initialize(std::vector<GameObject^> objects) override;
+    virtual void Initialize(std::vector<GameObject^> const& objects) override;
 };
@@ -26,7 +26,7 @@ Level5::Level5()
 
 //----------------------------------------------------------------------
 
-void Level5::Initialize(std::vector<GameObject^> objects)
+void Level5::Initialize(std::vector<GameObject^> const& objects)
 {
     Level3::Initialize(objects);
 
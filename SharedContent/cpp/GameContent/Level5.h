@@ -22,5 +22,5 @@ ref class Level5: public Level3
 {
 internal:
     Level5();
-    virtual void Initialize(std::vector<GameObject^> objects) override;
+    virtual void Initialize(std::vector<GameObject^> const& objects) override;
 };
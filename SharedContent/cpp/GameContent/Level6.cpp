@@ -22,24 +22,56 @@ Level6::Level6()
 
 //----------------------------------------------------------------------
 
+void Level6::Initialize(std::vector<GameObject^> const& objects)
+{
+    Level5::Initialize(objects);
+
+    m_timers.Reset(0.0f);
+}
+
+//----------------------------------------------------------------------
+
 bool Level6::Update(
     float time,
     float elapsedTime,
     float timeRemaining,
-    std::vector<GameObject^> objects
+    std::vector<GameObject^> const& /* objects */
     )
 {
-    for (auto object = objects.begin(); object != objects.end(); object++)
+    m_tracker.TakeHits(m_hits);
+    for (auto object = m_hits.begin(); object != m_hits.end(); object++)
     {
         if ((*object)->Active() && (*object)->Target())
         {
-            if ((*object)->Hit() && ((*object)->HitTime() < (time - 2.0f)))
-            {
-                (*object)->Hit(false);
-            }
+            ScheduleUnhit(m_timers, *object, (*object)->HitTime());
         }
     }
+    m_timers.Advance(time);
+
     return ((timeRemaining - elapsedTime) <= 0.0f);
 }
 
-//----------------------------------------------------------------------
\ No newline at end of file
+//----------------------------------------------------------------------
+
+void Level6::ScheduleUnhit(TimerWheel& timers, _In_ GameObject^ target, float hitTime)
+{
+    timers.Schedule(
+        hitTime + 2.0f,
+        [target, hitTime](TimerWheel& timers)
+        {
+            if (!target->Active() || !target->Target() || !target->Hit())
+            {
+                return;
+            }
+            if (target->HitTime() != hitTime)
+            {
+                // Hit again while still highlighted; the two seconds start over.
+                ScheduleUnhit(timers, target, target->HitTime());
+                return;
+            }
+            target->Hit(false);
+        }
+        );
+}
+
+//----------------------------------------------------------------------
@@ -16,6 +16,10 @@
 // fifth level.  In this level the targets do not disappear when they are hit.
 // The target will stay highlighted for two seconds.  As this is the last level
 // the only criteria for completion is time expiring.
+//
+// Each hit schedules the end of its highlight on the level's timer wheel, so a step only
+// does work for the highlights that end in it.  The game timer starts again at 0 each time
+// the level starts, so Initialize starts the wheel there as well.
 
 #include "Level5.h"
 
@@ -23,10 +27,14 @@ ref class Level6: public Level5
 {
 internal:
     Level6();
+    virtual void Initialize(std::vector<GameObject^> const& objects) override;
     virtual bool Update(
         float time,
         float elapsedTime,
         float timeRemaining,
-        std::vector<GameObject^> objects
+        std::vector<GameObject^> const& objects
         ) override;
+
+private:
+    static void ScheduleUnhit(TimerWheel& timers, _In_ GameObject^ target, float hitTime);
 };
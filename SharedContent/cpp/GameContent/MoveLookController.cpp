@@ -46,7 +46,9 @@ MoveLookController::MoveLookController(_In_ CoreWindow^ window, _In_ CoreDispatc
     m_state(MoveLookControllerState::None),
     m_gamepadStartButtonInUse(false),
     m_gamepadTriggerInUse(false),
-    m_gamepadsChanged(true)
+    m_gamepadsChanged(true),
+    m_frame(),
+    m_framePending(false)
 {
     InitWindow(window);
 }
@@ -60,7 +62,9 @@ MoveLookController::MoveLookController(_In_ CoreWindow^ window):
     m_state(MoveLookControllerState::None),
     m_gamepadStartButtonInUse(false),
     m_gamepadTriggerInUse(false),
-    m_gamepadsChanged(true)
+    m_gamepadsChanged(true),
+    m_frame(),
+    m_framePending(false)
 {
     InitWindow(window);
 }
@@ -106,6 +110,11 @@ void MoveLookController::InitWindow(_In_ CoreWindow^ window)
 
 bool MoveLookController::IsPauseRequested()
 {
+    if (m_replayLog != nullptr)
+    {
+        return ReplayQuery(&m_frame.pauseRequested, true);
+    }
+
     switch (m_state)
     {
     case MoveLookControllerState::Active:
@@ -116,6 +125,7 @@ bool MoveLookController::IsPauseRequested()
             DebugTrace(L"IsPauseRequested == true\n");
 #endif
             m_pausePressed = false;
+            m_frame.pauseRequested = true;
             return true;
         }
         else
@@ -130,17 +140,25 @@ bool MoveLookController::IsPauseRequested()
 
 bool MoveLookController::IsFiring()
 {
+    if (m_replayLog != nullptr)
+    {
+        return ReplayQuery(&m_frame.firing, !m_autoFire);
+    }
+
     if (m_state == MoveLookControllerState::Active)
     {
         if (m_autoFire)
         {
-            return (m_fireInUse || (m_mouseInUse && m_mouseLeftInUse) || PollingFireInUse());
+            bool firing = (m_fireInUse || (m_mouseInUse && m_mouseLeftInUse) || PollingFireInUse());
+            m_frame.firing |= firing;
+            return firing;
         }
         else
         {
             if (m_firePressed)
             {
                 m_firePressed = false;
+                m_frame.firing = true;
                 return true;
             }
         }
@@ -152,6 +170,11 @@ bool MoveLookController::IsFiring()
 
 bool MoveLookController::IsPressComplete()
 {
+    if (m_replayLog != nullptr)
+    {
+        return ReplayQuery(&m_frame.pressComplete, true);
+    }
+
     switch (m_state)
     {
     case MoveLookControllerState::WaitForInput:
@@ -162,6 +185,7 @@ bool MoveLookController::IsPressComplete()
             DebugTrace(L"IsPressComplete == true\n");
 #endif
             m_buttonPressed = false;
+            m_frame.pressComplete = true;
             return true;
         }
         else
@@ -1004,6 +1028,26 @@ bool MoveLookController::AutoFire()
 
 void MoveLookController::Update()
 {
+    if (m_replayLog != nullptr)
+    {
+        if (m_replayLog->Next(&m_frame))
+        {
+            m_velocity = XMFLOAT3(m_frame.velocity[0], m_frame.velocity[1], m_frame.velocity[2]);
+            m_pitch = m_frame.pitch;
+            m_yaw = m_frame.yaw;
+            return;
+        }
+
+        // The log is used up: continue with live input from this frame on.
+        m_replayLog = nullptr;
+        ResetState();
+    }
+
+    if (m_recordLog != nullptr && m_framePending)
+    {
+        m_recordLog->Append(m_frame);
+    }
+
     UpdatePollingDevices();
 
     if (m_moveInUse)
@@ -1071,6 +1115,85 @@ void MoveLookController::Update()
 
     // Clear movement input accumulator for use during next frame.
     m_moveCommand = XMFLOAT3(0.0f, 0.0f, 0.0f);
+
+    // Start the frame the queries of this update are recorded in.
+    m_frame.velocity[0] = m_velocity.x;
+    m_frame.velocity[1] = m_velocity.y;
+    m_frame.velocity[2] = m_velocity.z;
+    m_frame.pitch = m_pitch;
+    m_frame.yaw = m_yaw;
+    m_frame.frameTime = 0.0f;
+    m_frame.firing = false;
+    m_frame.pauseRequested = false;
+    m_frame.pressComplete = false;
+    m_framePending = (m_recordLog != nullptr);
+}
+
+//----------------------------------------------------------------------
+
+float MoveLookController::FrameTime(_In_ float measured)
+{
+    if (m_replayLog != nullptr)
+    {
+        return m_frame.frameTime;
+    }
+    m_frame.frameTime = measured;
+    return measured;
+}
+
+//----------------------------------------------------------------------
+
+void MoveLookController::Record(_In_ std::shared_ptr<InputLog> const& log)
+{
+    StopRecording();
+    m_recordLog = log;
+}
+
+//----------------------------------------------------------------------
+
+void MoveLookController::StopRecording()
+{
+    if (m_recordLog != nullptr && m_framePending)
+    {
+        m_recordLog->Append(m_frame);
+    }
+    m_recordLog = nullptr;
+    m_framePending = false;
+}
+
+//----------------------------------------------------------------------
+
+void MoveLookController::Replay(_In_ std::shared_ptr<InputLog> const& log)
+{
+    StopRecording();
+    log->Rewind();
+    m_replayLog = log;
+
+    // Until the first replayed Update the queries report nothing, rather than what the
+    // last live frame left behind.
+    m_frame.firing = false;
+    m_frame.pauseRequested = false;
+    m_frame.pressComplete = false;
+}
+
+//----------------------------------------------------------------------
+
+bool MoveLookController::Replaying()
+{
+    return m_replayLog != nullptr;
+}
+
+//----------------------------------------------------------------------
+
+bool MoveLookController::ReplayQuery(_Inout_ bool* recorded, bool edge)
+{
+    // An edge triggered query reports a recorded press once, as it did when recorded.
+    bool result = *recorded;
+    if (edge)
+    {
+        *recorded = false;
+    }
+    return result;
 }
 
 //----------------------------------------------------------------------
@@ -93,6 +93,17 @@
 // On the Update method it calls UpdatePollingDevices to update state.
 // All the inputs are coalesced and merged to generate a velocity vector
 // and update the Pitch and Yaw values.
+//
+// The controller can record what it reports to the game into an InputLog and later replay
+// it in place of live input, frame by frame and bit for bit.  While recording, each Update
+// starts a frame with the velocity, pitch and yaw it computed; IsFiring, IsPauseRequested
+// and IsPressComplete mark the frame when they return true; and FrameTime, called after
+// Update, stores the time step the game loop is about to simulate.  While replaying,
+// Update loads the next frame instead of reading the devices, the queries return what
+// was recorded, and FrameTime returns the recorded step in place of the measured one.
+// Replay ends at the end of the log and the controller goes back to live input.
+
+#include "InputLog.h"
 
 // Uncomment the next line to print debug tracing information.
 // #define MOVELOOKCONTROLLER_TRACE 1
@@ -154,12 +165,21 @@ internal:
     bool AutoFire();
     void AutoFire(_In_ bool AutoFire);
 
+    // Returns the time step to simulate this frame: the measured one unless replaying.
+    float FrameTime(_In_ float measured);
+
+    void Record(_In_ std::shared_ptr<InputLog> const& log);
+    void Replay(_In_ std::shared_ptr<InputLog> const& log);
+    void StopRecording();
+    bool Replaying();
+
 private:
     void ResetState();
     void UpdatePollingDevices();
     bool PollingFireInUse() { return m_gamepadTriggerInUse; }
     void ShowCursor();
     void HideCursor();
+    bool ReplayQuery(_Inout_ bool* recorded, bool edge);
 
     void OnPointerPressed(
         _In_ Windows::UI::Core::CoreWindow^ sender,
@@ -269,4 +289,10 @@ private:
     std::atomic<bool>                   m_gamepadsChanged;
     bool                                m_gamepadStartButtonInUse;
     bool                                m_gamepadTriggerInUse;
+
+    // Record and replay.
+    std::shared_ptr<InputLog>           m_recordLog;
+    std::shared_ptr<InputLog>           m_replayLog;
+    InputFrame                          m_frame;                // Frame being recorded or replayed.
+    bool                                m_framePending;         // m_frame has not been appended yet.
 };
@@ -0,0 +1,140 @@
+//********************************************************* 
+// 
+// Copyright (c) Microsoft. All rights reserved. 
+// This code is licensed under the MIT License (MIT). 
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF 
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY 
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR 
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT. 
+// 
+//*********************************************************
+
+#include "pch.h"
+#include "ObjectiveTracker.h"
+
+//----------------------------------------------------------------------
+
+ObjectiveTracker::ObjectiveTracker() :
+    m_targetsLeft(0),
+    m_numberedLeft(0)
+{
+}
+
+//----------------------------------------------------------------------
+
+ObjectiveTracker::~ObjectiveTracker()
+{
+    Untrack();
+}
+
+//----------------------------------------------------------------------
+
+void ObjectiveTracker::Track(std::vector<GameObject^> const& objects)
+{
+    Untrack();
+
+    for (auto object = objects.begin(); object != objects.end(); object++)
+    {
+        Entry entry = { *object, false, false, false, 0 };
+        m_entries.push_back(entry);
+        (*object)->Tracker(this, static_cast<unsigned int>(m_entries.size() - 1));
+    }
+
+    // Take the current state as a change from nothing, so that targets that are already
+    // hit are reported like later hits.
+    for (unsigned int i = 0; i < m_entries.size(); i++)
+    {
+        OnChanged(m_entries[i].object, i);
+    }
+}
+
+//----------------------------------------------------------------------
+
+void ObjectiveTracker::Untrack()
+{
+    // The levels share one list of objects, so another tracker may have taken some of
+    // them over since; leave those with it.
+    for (auto entry = m_entries.begin(); entry != m_entries.end(); entry++)
+    {
+        if (entry->object->Tracker() == this)
+        {
+            entry->object->Tracker(nullptr, 0);
+        }
+    }
+    m_entries.clear();
+    m_numbered.clear();
+    m_hits.clear();
+    m_targetsLeft = 0;
+    m_numberedLeft = 0;
+}
+
+//----------------------------------------------------------------------
+
+void ObjectiveTracker::OnChanged(_In_ GameObject^ object, unsigned int index)
+{
+    Entry& entry = m_entries[index];
+    Count(entry, false);
+
+    if (entry.targetId != object->TargetId())
+    {
+        if (entry.targetId > 0 && entry.targetId < static_cast<int>(m_numbered.size()) && m_numbered[entry.targetId] == object)
+        {
+            m_numbered[entry.targetId] = nullptr;
+        }
+        entry.targetId = object->TargetId();
+        if (entry.targetId > 0)
+        {
+            if (entry.targetId >= static_cast<int>(m_numbered.size()))
+            {
+                m_numbered.resize(entry.targetId + 1);
+            }
+            m_numbered[entry.targetId] = object;
+        }
+    }
+
+    bool hit = object->Hit();
+    if (hit && !entry.hit)
+    {
+        m_hits.push_back(object);
+    }
+    entry.active = object->Active();
+    entry.target = object->Target();
+    entry.hit = hit;
+
+    Count(entry, true);
+}
+
+//----------------------------------------------------------------------
+
+void ObjectiveTracker::Count(Entry const& entry, bool add)
+{
+    if (entry.active && entry.target && !entry.hit)
+    {
+        add ? m_targetsLeft++ : m_targetsLeft--;
+    }
+    if (entry.active && entry.targetId > 0)
+    {
+        add ? m_numberedLeft++ : m_numberedLeft--;
+    }
+}
+
+//----------------------------------------------------------------------
+
+GameObject^ ObjectiveTracker::Numbered(int targetId)
+{
+    if (targetId <= 0 || targetId >= static_cast<int>(m_numbered.size()))
+    {
+        return nullptr;
+    }
+    return m_numbered[targetId];
+}
+
+//----------------------------------------------------------------------
+
+void ObjectiveTracker::TakeHits(_Inout_ std::vector<GameObject^>& hits)
+{
+    hits.clear();
+    hits.swap(m_hits);
+}
+
+//----------------------------------------------------------------------
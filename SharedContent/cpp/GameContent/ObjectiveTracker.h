@@ -0,0 +1,75 @@
+//********************************************************* 
+// 
+// Copyright (c) Microsoft. All rights reserved. 
+// This code is licensed under the MIT License (MIT). 
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF 
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY 
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR 
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT. 
+// 
+//*********************************************************
+
+#pragma once
+
+// ObjectiveTracker:
+// This class keeps the numbers a level needs to decide whether its objective is met, so
+// that Level Update doesn't have to look at every object on every step.  Once Track has
+// taken a snapshot of the objects, each object reports to the tracker when its Active,
+// Target, Hit or TargetId state changes, and the tracker adjusts its counts for that one
+// object.  It also keeps, in order, the objects that have been hit since the level last
+// asked, and which object carries each target id.
+//
+// The tracker is owned by the level and holds the objects; each object points back to
+// it without holding it, and the tracker detaches itself when it goes away.  An object
+// reports to the tracker that tracked it last, so when the next level tracks the same
+// objects the old tracker stops hearing about them and leaves them attached to the new one.
+
+#include "GameObject.h"
+
+class ObjectiveTracker
+{
+public:
+    ObjectiveTracker();
+    ~ObjectiveTracker();
+
+    void Track(std::vector<GameObject^> const& objects);
+    void Untrack();
+
+    // Called by GameObject after one of the tracked properties has changed.
+    void OnChanged(_In_ GameObject^ object, unsigned int index);
+
+    unsigned int TargetsLeft();                 // Active targets that have not been hit.
+    unsigned int NumberedLeft();                // Active objects with a TargetId.
+    GameObject^ Numbered(int targetId);         // The object with this TargetId, or nullptr.
+
+    // Moves the objects hit since the last call, oldest first, into hits.
+    void TakeHits(_Inout_ std::vector<GameObject^>& hits);
+
+private:
+    struct Entry
+    {
+        GameObject^ object;
+        bool        active;
+        bool        target;
+        bool        hit;
+        int         targetId;
+    };
+
+    void Count(Entry const& entry, bool add);
+
+    std::vector<Entry>          m_entries;
+    std::vector<GameObject^>    m_numbered;     // Indexed by TargetId.
+    std::vector<GameObject^>    m_hits;
+    unsigned int                m_targetsLeft;
+    unsigned int                m_numberedLeft;
+};
+
+__forceinline unsigned int ObjectiveTracker::TargetsLeft()
+{
+    return m_targetsLeft;
+}
+
+__forceinline unsigned int ObjectiveTracker::NumberedLeft()
+{
+    return m_numberedLeft;
+}
@@ -11,6 +11,7 @@
 
 #include "pch.h"
 #include "Sphere.h"
+#include "SweptCollision.h"
 
 using namespace DirectX;
 
@@ -48,6 +49,17 @@ void Sphere::Update()
 
 //----------------------------------------------------------------------
 
+void Sphere::Bounds(
+    _Out_ XMFLOAT3 *minimum,
+    _Out_ XMFLOAT3 *maximum
+    )
+{
+    XMStoreFloat3(minimum, XMLoadFloat3(&m_position) - XMVectorReplicate(m_radius));
+    XMStoreFloat3(maximum, XMLoadFloat3(&m_position) + XMVectorReplicate(m_radius));
+}
+
+//----------------------------------------------------------------------
+
 bool Sphere::IsTouching(
     XMFLOAT3 point,
     float radius,
@@ -81,3 +93,37 @@ bool Sphere::IsTouching(
 }
 
 //----------------------------------------------------------------------
+
+bool Sphere::TimeOfImpact(
+    XMFLOAT3 point,
+    float radius,
+    XMFLOAT3 motion,
+    _Out_ float *t,
+    _Out_ XMFLOAT3 *contact,
+    _Out_ XMFLOAT3 *normal
+    )
+{
+    XMVECTOR center = XMLoadFloat3(&m_position);
+    XMVECTOR move = XMLoadFloat3(&motion);
+    float enter = 0.0f;
+    float exit = 1.0f;
+
+    if (!SweptCollision::ClipRound(XMLoadFloat3(&point) - center, move, radius + m_radius, &enter, &exit))
+    {
+        return false;
+    }
+
+    // Unlike IsTouching, the normal points from this sphere toward the moving one, as it
+    // does for the other shapes, and the contact is on this sphere's surface.
+    XMVECTOR outward = XMVector3Normalize(XMLoadFloat3(&point) + move * enter - center);
+    if (!(enter > 0.0f || XMVectorGetX(XMVector3Dot(move, outward)) < 0.0f))
+    {
+        return false;
+    }
+    XMStoreFloat3(normal, outward);
+    XMStoreFloat3(contact, center + outward * m_radius);
+    *t = enter;
+    return true;
+}
+
+//----------------------------------------------------------------------
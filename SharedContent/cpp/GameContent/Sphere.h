@@ -28,6 +28,11 @@ internal:
     void Radius(float radius);
     float Radius();
 
+    virtual void Bounds(
+        _Out_ DirectX::XMFLOAT3 *minimum,
+        _Out_ DirectX::XMFLOAT3 *maximum
+        ) override;
+
     virtual bool IsTouching(
         DirectX::XMFLOAT3 point,
         float radius,
@@ -35,6 +40,15 @@ internal:
         _Out_ DirectX::XMFLOAT3 *normal
         ) override;
 
+    virtual bool TimeOfImpact(
+        DirectX::XMFLOAT3 point,
+        float radius,
+        DirectX::XMFLOAT3 motion,
+        _Out_ float *t,
+        _Out_ DirectX::XMFLOAT3 *contact,
+        _Out_ DirectX::XMFLOAT3 *normal
+        ) override;
+
 private:
     void Update();
 
@@ -45,18 +59,21 @@ private:
 __forceinline void Sphere::Position(DirectX::XMFLOAT3 position)
 {
     m_position = position;
+    m_positionVersion++;
     Update();
 }
 
 __forceinline void Sphere::Position(DirectX::XMVECTOR position)
 {
     DirectX::XMStoreFloat3(&m_position, position);
+    m_positionVersion++;
     Update();
 }
 
 __forceinline void Sphere::Radius(float radius)
 {
     m_radius = radius;
+    m_positionVersion++;
     Update();
 }
 
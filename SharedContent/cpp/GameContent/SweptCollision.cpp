@@ -0,0 +1,55 @@
+//********************************************************* 
+// 
+// Copyright (c) Microsoft. All rights reserved. 
+// This code is licensed under the MIT License (MIT). 
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF 
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY 
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR 
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT. 
+// 
+//*********************************************************
+
+#include "pch.h"
+#include "SweptCollision.h"
+
+using namespace DirectX;
+
+//----------------------------------------------------------------------
+
+bool FirstImpact(
+    XMFLOAT3 point,
+    float radius,
+    XMFLOAT3 motion,
+    std::vector<GameObject^> const& objects,
+    _In_opt_ GameObject^ ignore,
+    _Out_ Impact* impact
+    )
+{
+    bool found = false;
+    impact->object = nullptr;
+    impact->t = 1.0f;
+
+    for (auto object = objects.begin(); object != objects.end(); object++)
+    {
+        if (*object == ignore || !(*object)->Active())
+        {
+            continue;
+        }
+
+        float t;
+        XMFLOAT3 contact;
+        XMFLOAT3 normal;
+        if ((*object)->TimeOfImpact(point, radius, motion, &t, &contact, &normal) &&
+            (!found || t < impact->t))
+        {
+            found = true;
+            impact->object = *object;
+            impact->t = t;
+            impact->contact = contact;
+            impact->normal = normal;
+        }
+    }
+    return found;
+}
+
+//----------------------------------------------------------------------
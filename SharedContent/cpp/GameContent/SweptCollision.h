@@ -0,0 +1,103 @@
+//********************************************************* 
+// 
+// Copyright (c) Microsoft. All rights reserved. 
+// This code is licensed under the MIT License (MIT). 
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF 
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY 
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR 
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT. 
+// 
+//*********************************************************
+
+#pragma once
+
+// SweptCollision:
+// Continuous collision for a sphere that moves in a straight line during a time step.
+// Each shape's TimeOfImpact returns the fraction of the step at which the sphere first
+// satisfies that shape's IsTouching test, so a fast sphere can't pass through a thin
+// face between two steps and the step doesn't have to be cut into many short ones.
+// FirstImpact finds the earliest impact among a set of objects; the physics moves the
+// sphere there, responds, and sweeps the rest of the step, for a few impacts per step.
+//
+// The shapes describe the set of positions at which they touch a sphere as the
+// intersection of slabs (a linear distance within a limit) and round regions (a squared
+// distance within a limit).  Along the motion each of those is an interval of time, so the
+// time of impact is the start of the intersection of the intervals.
+
+#include "GameObject.h"
+
+struct Impact
+{
+    GameObject^       object;
+    float             t;
+    DirectX::XMFLOAT3 contact;
+    DirectX::XMFLOAT3 normal;
+};
+
+// Returns false when the sphere touches no active object other than ignore during the step.
+bool FirstImpact(
+    DirectX::XMFLOAT3 point,
+    float radius,
+    DirectX::XMFLOAT3 motion,
+    std::vector<GameObject^> const& objects,
+    _In_opt_ GameObject^ ignore,
+    _Out_ Impact* impact
+    );
+
+namespace SweptCollision
+{
+    // Narrows [*enter, *exit] to the times at which |start + t * rate| < limit.
+    __forceinline bool ClipSlab(
+        float start,
+        float rate,
+        float limit,
+        _Inout_ float* enter,
+        _Inout_ float* exit
+        )
+    {
+        if (rate == 0.0f)
+        {
+            return fabsf(start) < limit;
+        }
+        float t0 = (-limit - start) / rate;
+        float t1 = (limit - start) / rate;
+        if (t0 > t1)
+        {
+            float swap = t0;
+            t0 = t1;
+            t1 = swap;
+        }
+        *enter = max(*enter, t0);
+        *exit = min(*exit, t1);
+        return *enter < *exit;
+    }
+
+    // Narrows [*enter, *exit] to the times at which |start + t * rate| < limit for vectors.
+    __forceinline bool ClipRound(
+        DirectX::FXMVECTOR start,
+        DirectX::FXMVECTOR rate,
+        float limit,
+        _Inout_ float* enter,
+        _Inout_ float* exit
+        )
+    {
+        float a = DirectX::XMVectorGetX(DirectX::XMVector3Dot(rate, rate));
+        float b = DirectX::XMVectorGetX(DirectX::XMVector3Dot(start, rate));
+        float c = DirectX::XMVectorGetX(DirectX::XMVector3Dot(start, start)) - limit * limit;
+        if (a == 0.0f)
+        {
+            return c < 0.0f;
+        }
+
+        // a t^2 + 2 b t + c < 0 between the roots.
+        float discriminant = b * b - a * c;
+        if (discriminant <= 0.0f)
+        {
+            return false;
+        }
+        float root = sqrtf(discriminant);
+        *enter = max(*enter, (-b - root) / a);
+        *exit = min(*exit, (-b + root) / a);
+        return *enter < *exit;
+    }
+};
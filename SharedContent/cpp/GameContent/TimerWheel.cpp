@@ -0,0 +1,363 @@
+//********************************************************* 
+// 
+// Copyright (c) Microsoft. All rights reserved. 
+// This code is licensed under the MIT License (MIT). 
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF 
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY 
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR 
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT. 
+// 
+//*********************************************************
+
+#include "pch.h"
+#include "TimerWheel.h"
+
+//----------------------------------------------------------------------
+
+namespace
+{
+    // Index of the lowest set bit; bits must not be 0.
+    __forceinline unsigned int LowestBit(unsigned __int64 bits)
+    {
+        unsigned long index;
+        if (static_cast<unsigned int>(bits) != 0)
+        {
+            _BitScanForward(&index, static_cast<unsigned long>(bits));
+            return index;
+        }
+        _BitScanForward(&index, static_cast<unsigned long>(bits >> 32));
+        return index + 32;
+    }
+}
+
+//----------------------------------------------------------------------
+
+TimerWheel::TimerWheel(float ticksPerSecond) :
+    m_ticksPerSecond(ticksPerSecond),
+    m_time(0.0f),
+    m_tick(0),
+    m_count(0),
+    m_sequence(0),
+    m_freeTimer(NoTimer)
+{
+    if (!(ticksPerSecond > 0.0f))
+    {
+        throw ref new Platform::InvalidArgumentException();
+    }
+    Reset(0.0f);
+}
+
+//----------------------------------------------------------------------
+
+TimerHandle TimerWheel::Schedule(float time, Callback const& callback)
+{
+    unsigned int index = m_freeTimer;
+    if (index == NoTimer)
+    {
+        Timer timer;
+        timer.list = NoTimer;
+        timer.generation = 0;
+        m_timers.push_back(timer);
+        index = static_cast<unsigned int>(m_timers.size() - 1);
+    }
+    else
+    {
+        m_freeTimer = m_timers[index].next;
+    }
+
+    // Round up, so that the timer doesn't run before its time.
+    float ticks = ceilf(time * m_ticksPerSecond);
+    Timer& timer = m_timers[index];
+    timer.callback = callback;
+    timer.due = (ticks > 0.0f) ? static_cast<unsigned __int64>(ticks) : 0;
+    timer.sequence = m_sequence++;
+    m_count++;
+    Place(index);
+
+    TimerHandle handle = { index, timer.generation };
+    return handle;
+}
+
+//----------------------------------------------------------------------
+
+TimerHandle TimerWheel::ScheduleAfter(float delay, Callback const& callback)
+{
+    return Schedule(Now() + delay, callback);
+}
+
+//----------------------------------------------------------------------
+
+bool TimerWheel::Cancel(TimerHandle handle)
+{
+    if (!Pending(handle))
+    {
+        return false;
+    }
+    Unlink(handle.index);
+    Free(handle.index);
+    return true;
+}
+
+//----------------------------------------------------------------------
+
+bool TimerWheel::Pending(TimerHandle handle)
+{
+    return (handle.index < m_timers.size()) &&
+        (m_timers[handle.index].generation == handle.generation) &&
+        (m_timers[handle.index].list != NoTimer);
+}
+
+//----------------------------------------------------------------------
+
+void TimerWheel::Advance(float time)
+{
+    m_time = max(m_time, time);
+    float ticks = floorf(time * m_ticksPerSecond);
+    unsigned __int64 target = (ticks > 0.0f) ? static_cast<unsigned __int64>(ticks) : 0;
+
+    RunDue();
+    while (m_tick < target)
+    {
+        unsigned __int64 next = NextSlotTick();
+        if (next > target)
+        {
+            m_tick = target;
+            break;
+        }
+
+        m_tick = next;
+        if ((m_tick & SlotMask) == 0)
+        {
+            Cascade(1);
+        }
+
+        // Move the slot to the due list.  Cascade may have put timers that are due at this
+        // tick straight into the due list; Link keeps them all in scheduling order.
+        unsigned int slot = static_cast<unsigned int>(m_tick & SlotMask);
+        for (unsigned int index = m_lists[slot].head; index != NoTimer;)
+        {
+            unsigned int following = m_timers[index].next;
+            Unlink(index);
+            Link(index, DueList);
+            index = following;
+        }
+        RunDue();
+    }
+}
+
+//----------------------------------------------------------------------
+
+void TimerWheel::Update(_In_ GameTimer^ timer)
+{
+    Advance(timer->PlayingTime());
+}
+
+//----------------------------------------------------------------------
+
+void TimerWheel::Reset(float time)
+{
+    // Keep the timers so that handles from before the Reset are recognized as stale.
+    for (unsigned int index = 0; index < m_timers.size(); index++)
+    {
+        if (m_timers[index].list != NoTimer)
+        {
+            m_timers[index].list = NoTimer;
+            Free(index);
+        }
+    }
+    for (unsigned int list = 0; list <= DueList; list++)
+    {
+        m_lists[list].head = NoTimer;
+        m_lists[list].tail = NoTimer;
+    }
+    for (unsigned int level = 0; level < Levels; level++)
+    {
+        m_occupied[level] = 0;
+    }
+
+    m_time = time;
+    float ticks = floorf(time * m_ticksPerSecond);
+    m_tick = (ticks > 0.0f) ? static_cast<unsigned __int64>(ticks) : 0;
+}
+
+//----------------------------------------------------------------------
+
+void TimerWheel::Place(unsigned int index)
+{
+    unsigned __int64 due = m_timers[index].due;
+    if (due <= m_tick)
+    {
+        Link(index, DueList);
+        return;
+    }
+
+    // The first level whose range covers the distance to the due tick.
+    unsigned __int64 distance = due - m_tick;
+    unsigned int level = 0;
+    while ((level < Levels - 1) && (distance >= (static_cast<unsigned __int64>(1) << (LevelBits * (level + 1)))))
+    {
+        level++;
+    }
+    if (distance >= (static_cast<unsigned __int64>(1) << (LevelBits * Levels)))
+    {
+        // Beyond the last wheel: wait in the slot that comes round last.
+        due = m_tick + (static_cast<unsigned __int64>(1) << (LevelBits * Levels)) - 1;
+    }
+    unsigned int slot = static_cast<unsigned int>((due >> (LevelBits * level)) & SlotMask);
+    Link(index, level * SlotCount + slot);
+}
+
+//----------------------------------------------------------------------
+
+void TimerWheel::Link(unsigned int index, unsigned int list)
+{
+    // Keep the list in scheduling order.  A newly scheduled timer goes at the tail; only
+    // a timer coming down from a higher wheel can have later timers ahead of it.
+    Timer& timer = m_timers[index];
+    List& target = m_lists[list];
+    unsigned int previous = target.tail;
+    while (previous != NoTimer && m_timers[previous].sequence > timer.sequence)
+    {
+        previous = m_timers[previous].previous;
+    }
+    unsigned int next = (previous == NoTimer) ? target.head : m_timers[previous].next;
+
+    timer.list = list;
+    timer.previous = previous;
+    timer.next = next;
+    if (previous == NoTimer)
+    {
+        target.head = index;
+    }
+    else
+    {
+        m_timers[previous].next = index;
+    }
+    if (next == NoTimer)
+    {
+        target.tail = index;
+    }
+    else
+    {
+        m_timers[next].previous = index;
+    }
+
+    if (list < DueList)
+    {
+        m_occupied[list / SlotCount] |= static_cast<unsigned __int64>(1) << (list & SlotMask);
+    }
+}
+
+//----------------------------------------------------------------------
+
+void TimerWheel::Unlink(unsigned int index)
+{
+    Timer& timer = m_timers[index];
+    List& source = m_lists[timer.list];
+    if (timer.previous == NoTimer)
+    {
+        source.head = timer.next;
+    }
+    else
+    {
+        m_timers[timer.previous].next = timer.next;
+    }
+    if (timer.next == NoTimer)
+    {
+        source.tail = timer.previous;
+    }
+    else
+    {
+        m_timers[timer.next].previous = timer.previous;
+    }
+
+    if ((timer.list < DueList) && (source.head == NoTimer))
+    {
+        m_occupied[timer.list / SlotCount] &= ~(static_cast<unsigned __int64>(1) << (timer.list & SlotMask));
+    }
+    timer.list = NoTimer;
+}
+
+//----------------------------------------------------------------------
+
+void TimerWheel::Free(unsigned int index)
+{
+    Timer& timer = m_timers[index];
+    timer.callback = nullptr;
+    timer.generation++;
+    timer.next = m_freeTimer;
+    m_freeTimer = index;
+    m_count--;
+}
+
+//----------------------------------------------------------------------
+
+void TimerWheel::Cascade(unsigned int level)
+{
+    // m_tick has just reached the start of a turn of every level below this one.
+    unsigned int slot = static_cast<unsigned int>((m_tick >> (LevelBits * level)) & SlotMask);
+    if ((slot == 0) && (level < Levels - 1))
+    {
+        Cascade(level + 1);
+    }
+
+    List& list = m_lists[level * SlotCount + slot];
+    unsigned int index = list.head;
+    while (index != NoTimer)
+    {
+        unsigned int following = m_timers[index].next;
+        Unlink(index);
+        Place(index);
+        index = following;
+    }
+}
+
+//----------------------------------------------------------------------
+
+unsigned __int64 TimerWheel::NextSlotTick()
+{
+    // The earliest tick after m_tick at which an occupied slot of any wheel comes round:
+    // the slot runs if it is on the first wheel and is spread over the wheel below if not.
+    // Every slot in between is empty, so skipping it changes nothing.
+    unsigned __int64 next = ~static_cast<unsigned __int64>(0);
+    for (unsigned int level = 0; level < Levels; level++)
+    {
+        unsigned __int64 occupied = m_occupied[level];
+        if (occupied == 0)
+        {
+            continue;
+        }
+
+        // Rotate the mask so that bit 0 is the slot after the current one; the current
+        // slot itself, if occupied, only comes round again after a full turn.
+        unsigned int shift = LevelBits * level;
+        unsigned __int64 position = m_tick >> shift;
+        unsigned int rotate = static_cast<unsigned int>((position + 1) & SlotMask);
+        if (rotate != 0)
+        {
+            occupied = (occupied >> rotate) | (occupied << (SlotCount - rotate));
+        }
+        unsigned __int64 tick = (position + LowestBit(occupied) + 1) << shift;
+        next = min(next, tick);
+    }
+    return next;
+}
+
+//----------------------------------------------------------------------
+
+void TimerWheel::RunDue()
+{
+    // A callback may schedule or cancel timers, including ones in the due list, so take
+    // one timer at a time and free it before it runs.
+    while (m_lists[DueList].head != NoTimer)
+    {
+        unsigned int index = m_lists[DueList].head;
+        Callback callback;
+        callback.swap(m_timers[index].callback);
+        Unlink(index);
+        Free(index);
+        callback(*this);
+    }
+}
+
+//----------------------------------------------------------------------
@@ -0,0 +1,122 @@
+//********************************************************* 
+// 
+// Copyright (c) Microsoft. All rights reserved. 
+// This code is licensed under the MIT License (MIT). 
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF 
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY 
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR 
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT. 
+// 
+//*********************************************************
+
+#pragma once
+
+// TimerWheel:
+// This class runs callbacks at given game times, for events such as "un-hit this target
+// two seconds from now".  Time is the playing time of a GameTimer, so a stopped timer
+// stops the wheel as well and nothing fires while the game is paused.
+//
+// Time is cut into ticks of 1 / ticksPerSecond.  A timer is put in a slot of one of four
+// wheels of 64 slots: the first wheel holds the timers due in the next 64 ticks, one slot
+// per tick, the second the timers due in the next 64 * 64 ticks, one slot per 64 ticks,
+// and so on.  When the first wheel comes round, the next slot of the second wheel is
+// spread over it, and likewise further up.  Scheduling and cancelling are O(1).  Advance
+// uses a bit mask of the occupied slots of each wheel to go straight to the next slot, on
+// any wheel, that has timers in it, so its cost depends on the timers that run or move
+// down and not on how much time passes.  A timer is never run before its time and at most
+// one tick after the Advance that passes it.  Timers further out than the four wheels
+// reach (about 39 hours at 120 ticks per second) wait in the last slot and are placed
+// again when it comes round.
+//
+// Timers due at the same tick run in the order they were scheduled, even when an earlier
+// one has come down from a higher wheel: every timer carries a sequence number, and each
+// list is kept in that order.  A callback gets the wheel, so it can schedule a follow-up
+// or cancel other timers without holding on to the wheel itself.  A timer scheduled for
+// a time that has already been reached runs on the next Advance, or before the current
+// one returns if a callback scheduled it.  Advance must not be called from a callback.
+//
+// Time that goes backwards is ignored; use Reset when the game is restarted at an earlier
+// time.
+
+#include <functional>
+#include "GameTimer.h"
+
+struct TimerHandle
+{
+    unsigned int index;
+    unsigned int generation;
+};
+
+class TimerWheel
+{
+public:
+    typedef std::function<void(TimerWheel& timers)> Callback;
+
+    explicit TimerWheel(float ticksPerSecond);
+
+    TimerHandle Schedule(float time, Callback const& callback);
+    TimerHandle ScheduleAfter(float delay, Callback const& callback);
+    bool Cancel(TimerHandle handle);            // Returns false if the timer has already run or been cancelled.
+    bool Pending(TimerHandle handle);
+
+    // Runs, in time order, the callbacks of the timers that are due at time.
+    void Advance(float time);
+    void Update(_In_ GameTimer^ timer);         // Advance to the timer's playing time.
+
+    void Reset(float time);                     // Drops every timer.
+    float Now();
+    unsigned int Count();
+
+private:
+    static const unsigned int LevelBits = 6;
+    static const unsigned int SlotCount = 1 << LevelBits;
+    static const unsigned int SlotMask  = SlotCount - 1;
+    static const unsigned int Levels    = 4;
+    static const unsigned int DueList   = Levels * SlotCount;
+    static const unsigned int NoTimer   = 0xffffffff;
+
+    struct Timer
+    {
+        Callback         callback;
+        unsigned __int64 due;               // In ticks.
+        unsigned __int64 sequence;          // Order of scheduling.
+        unsigned int     previous;
+        unsigned int     next;              // Also links the free timers.
+        unsigned int     list;              // NoTimer when the timer is free.
+        unsigned int     generation;
+    };
+
+    struct List
+    {
+        unsigned int head;
+        unsigned int tail;
+    };
+
+    void Place(unsigned int index);
+    void Link(unsigned int index, unsigned int list);
+    void Unlink(unsigned int index);
+    void Free(unsigned int index);
+    void Cascade(unsigned int level);
+    unsigned __int64 NextSlotTick();
+    void RunDue();
+
+    float                   m_ticksPerSecond;
+    float                   m_time;                         // The latest time given to Advance.
+    unsigned __int64        m_tick;                         // The tick of m_time, rounded down.
+    unsigned int            m_count;
+    unsigned __int64        m_sequence;
+    unsigned int            m_freeTimer;
+    std::vector<Timer>      m_timers;
+    List                    m_lists[DueList + 1];           // The slots of every level, then the due list.
+    unsigned __int64        m_occupied[Levels];             // One bit per slot that holds a timer.
+};
+
+__forceinline float TimerWheel::Now()
+{
+    return m_time;
+}
+
+__forceinline unsigned int TimerWheel::Count()
+{
+    return m_count;
+}
@@ -0,0 +1,242 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "pch.h"
+#include "BusinessDayCalendar.h"
+#include <algorithm>
+
+using namespace winrt;
+using namespace winrt::SDKTemplate::CalendarEngine;
+
+namespace
+{
+    inline uint32_t PopCount64(uint64_t value) noexcept
+    {
+        value = value - ((value >> 1) & 0x5555555555555555ull);
+        value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+        value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        return static_cast<uint32_t>((value * 0x0101010101010101ull) >> 56);
+    }
+
+    // Position of the rank-th set bit of a word.  The caller guarantees the bit exists.
+    inline uint32_t SelectInWord(uint64_t word, uint32_t rank) noexcept
+    {
+        uint32_t position = 0;
+        for (uint32_t width = 32; width >= 8; width /= 2)
+        {
+            uint32_t low = PopCount64(word & ((1ull << width) - 1));
+            if (rank >= low)
+            {
+                rank -= low;
+                word >>= width;
+                position += width;
+            }
+        }
+        for (; ; word >>= 1, position++)
+        {
+            if ((word & 1) != 0)
+            {
+                if (rank == 0)
+                {
+                    return position;
+                }
+                rank--;
+            }
+        }
+    }
+}
+
+BusinessDayCalendar::BusinessDayCalendar(
+    std::wstring region,
+    int32_t firstYear,
+    int32_t lastYear,
+    uint8_t weekendMask,
+    std::vector<CivilDate> const& holidays
+    ) :
+    m_region(std::move(region)),
+    m_firstYear(firstYear),
+    m_weekendMask(weekendMask)
+{
+    if (lastYear < firstYear || (weekendMask & 0x7F) == 0x7F)
+    {
+        throw hresult_invalid_argument();
+    }
+
+    m_firstDay = DaysFromCivil(firstYear, 1, 1);
+    m_dayCount = static_cast<uint32_t>(DaysFromCivil(lastYear + 1, 1, 1) - m_firstDay);
+
+    m_holidays.assign(static_cast<size_t>(lastYear - firstYear) + 1, {});
+    for (auto&& holiday : holidays)
+    {
+        if (holiday.year < firstYear || holiday.year > lastYear)
+        {
+            continue;
+        }
+        if (holiday.month < 1 || holiday.month > 12 || holiday.day < 1 || holiday.day > DaysInMonth(holiday.year, holiday.month))
+        {
+            throw hresult_invalid_argument();
+        }
+        uint32_t dayOfYear = static_cast<uint32_t>(DaysFromCivil(holiday) - DaysFromCivil(holiday.year, 1, 1));
+        m_holidays[holiday.year - firstYear][dayOfYear / 64] |= 1ull << (dayOfYear % 64);
+    }
+
+    // Fold the weekend mask into a repeating 7-day pattern, then clear the holidays.
+    size_t wordCount = (m_dayCount + 63) / 64;
+    m_business.assign(wordCount + 1, 0);
+    uint32_t weekday = WeekdayFromDays(m_firstDay);
+    for (uint32_t index = 0; index < m_dayCount; index++)
+    {
+        if ((m_weekendMask & (1u << weekday)) == 0)
+        {
+            m_business[index / 64] |= 1ull << (index % 64);
+        }
+        weekday = (weekday == 6) ? 0 : weekday + 1;
+    }
+
+    uint32_t yearStart = 0;
+    for (int32_t year = firstYear; year <= lastYear; year++)
+    {
+        auto const& bits = m_holidays[year - firstYear];
+        for (uint32_t word = 0; word < bits.size(); word++)
+        {
+            for (uint64_t remaining = bits[word]; remaining != 0; remaining &= remaining - 1)
+            {
+                uint32_t index = yearStart + word * 64 + SelectInWord(remaining, 0);
+                m_business[index / 64] &= ~(1ull << (index % 64));
+            }
+        }
+        yearStart += DaysInYear(year);
+    }
+
+    m_rank.resize(wordCount + 1);
+    uint32_t running = 0;
+    for (size_t word = 0; word <= wordCount; word++)
+    {
+        m_rank[word] = running;
+        running += PopCount64(m_business[word]);
+    }
+}
+
+bool BusinessDayCalendar::IsHoliday(int32_t day) const
+{
+    CivilDate date = CivilFromDays(day);
+    if (date.year < m_firstYear || date.year >= m_firstYear + static_cast<int32_t>(m_holidays.size()))
+    {
+        return false;
+    }
+    uint32_t dayOfYear = static_cast<uint32_t>(day - DaysFromCivil(date.year, 1, 1));
+    return (m_holidays[date.year - m_firstYear][dayOfYear / 64] & (1ull << (dayOfYear % 64))) != 0;
+}
+
+bool BusinessDayCalendar::IsBusinessDay(int32_t day) const
+{
+    if (day < m_firstDay || day > LastDay())
+    {
+        throw hresult_out_of_bounds();
+    }
+    uint32_t index = static_cast<uint32_t>(day - m_firstDay);
+    return (m_business[index / 64] & (1ull << (index % 64))) != 0;
+}
+
+// Number of business days among the first 'index' covered days.  index may equal m_dayCount.
+uint32_t BusinessDayCalendar::Rank(uint32_t index) const
+{
+    uint64_t below = (1ull << (index % 64)) - 1;
+    return m_rank[index / 64] + PopCount64(m_business[index / 64] & below);
+}
+
+// Index of the covered day that is business day number 'rank' (zero based).
+uint32_t BusinessDayCalendar::Select(uint32_t rank) const
+{
+    // Last word whose running count is <= rank; that word holds the answer.
+    auto word = std::upper_bound(m_rank.begin(), m_rank.end(), rank) - 1;
+    uint32_t wordIndex = static_cast<uint32_t>(word - m_rank.begin());
+    return wordIndex * 64 + SelectInWord(m_business[wordIndex], rank - *word);
+}
+
+int32_t BusinessDayCalendar::CountBusinessDays(int32_t from, int32_t to) const
+{
+    if (from < m_firstDay || to < m_firstDay || from > LastDay() + 1 || to > LastDay() + 1)
+    {
+        throw hresult_out_of_bounds();
+    }
+    return static_cast<int32_t>(Rank(static_cast<uint32_t>(to - m_firstDay))) -
+        static_cast<int32_t>(Rank(static_cast<uint32_t>(from - m_firstDay)));
+}
+
+bool BusinessDayCalendar::TryAddBusinessDays(int32_t from, int32_t count, _Out_ int32_t* result) const
+{
+    *result = InvalidDay;
+    if (from < m_firstDay || from > LastDay())
+    {
+        return false;
+    }
+    if (count == 0)
+    {
+        *result = from;
+        return true;
+    }
+
+    uint32_t index = static_cast<uint32_t>(from - m_firstDay);
+    int64_t target;
+    if (count > 0)
+    {
+        // Business days up to and including 'from', then count more.
+        target = static_cast<int64_t>(Rank(index + 1)) + count - 1;
+    }
+    else
+    {
+        target = static_cast<int64_t>(Rank(index)) + count;
+    }
+
+    if (target < 0 || target >= static_cast<int64_t>(m_rank.back()))
+    {
+        return false;
+    }
+    *result = m_firstDay + static_cast<int32_t>(Select(static_cast<uint32_t>(target)));
+    return true;
+}
+
+int32_t BusinessDayCalendar::AddBusinessDays(int32_t from, int32_t count) const
+{
+    int32_t result;
+    if (!TryAddBusinessDays(from, count, &result))
+    {
+        throw hresult_out_of_bounds();
+    }
+    return result;
+}
+
+size_t BusinessDayCalendar::AddBusinessDays(
+    _In_reads_(count) int32_t const* tradeDates,
+    int32_t lag,
+    _Out_writes_(count) int32_t* settlementDates,
+    size_t count
+    ) const
+{
+    // Trade files are usually grouped by date, so remember the last answer.
+    int32_t lastTrade = InvalidDay;
+    int32_t lastSettlement = InvalidDay;
+    size_t failures = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        int32_t trade = tradeDates[i];
+        if (trade != lastTrade)
+        {
+            lastTrade = trade;
+            TryAddBusinessDays(trade, lag, &lastSettlement);
+        }
+        settlementDates[i] = lastSettlement;
+        failures += (lastSettlement == InvalidDay) ? 1 : 0;
+    }
+    return failures;
+}
@@ -0,0 +1,99 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+// BusinessDayCalendar:
+// Answers "add N business days" and "business days between" for one region without
+// stepping through the dates one at a time.
+//
+// The holidays of each year are kept as a 366-bit set indexed by day of year, in six
+// plain 64-bit words rather than a compressed set: that is 48 bytes a year, under 10 KB
+// for two centuries, and IsHoliday stays a single word read, where a sparse or
+// run-length form would save little and cost a decode on every lookup.
+//
+// When the calendar is constructed the holidays and the weekend mask are folded into a
+// single bit set of business days covering [firstYear, lastYear], together with a running
+// count of business days at the start of every 64-bit word.  A count query is then two
+// table reads and two popcounts, and an add query is a binary search over the running
+// counts followed by a select inside one word.
+//
+// The calendar is immutable once constructed, so a single instance can be shared by
+// any number of threads running the batch API.
+
+#include <array>
+#include <string>
+#include <vector>
+#include "CivilDate.h"
+
+namespace winrt::SDKTemplate::CalendarEngine
+{
+    // Weekend days as a bit mask indexed by DayOfWeek (bit 0 = Sunday).
+    namespace WeekendMask
+    {
+        static const uint8_t SaturdaySunday = 0x41;
+        static const uint8_t FridaySaturday = 0x60;
+        static const uint8_t Friday         = 0x20;
+        static const uint8_t Sunday         = 0x01;
+    }
+
+    class BusinessDayCalendar
+    {
+    public:
+        // Holidays outside [firstYear, lastYear] are ignored; a holiday that is not a valid
+        // date throws hresult_invalid_argument.
+        BusinessDayCalendar(
+            std::wstring region,
+            int32_t firstYear,
+            int32_t lastYear,
+            uint8_t weekendMask,
+            std::vector<CivilDate> const& holidays
+            );
+
+        std::wstring const& Region() const { return m_region; }
+        int32_t FirstDay() const { return m_firstDay; }
+        int32_t LastDay() const { return m_firstDay + static_cast<int32_t>(m_dayCount) - 1; }
+
+        bool IsHoliday(int32_t day) const;
+        bool IsBusinessDay(int32_t day) const;
+
+        // Number of business days in [from, to).  Negative when to < from.
+        int32_t CountBusinessDays(int32_t from, int32_t to) const;
+
+        // The count-th business day after 'from' (before it when count is negative).
+        // 'from' does not need to be a business day itself; a count of zero returns it unchanged.
+        int32_t AddBusinessDays(int32_t from, int32_t count) const;
+
+        // Settlement-date computation: settlementDates[i] = AddBusinessDays(tradeDates[i], lag).
+        // Dates that cannot be resolved inside the calendar are written as InvalidDay instead
+        // of throwing; the return value is the number of such dates.
+        size_t AddBusinessDays(
+            _In_reads_(count) int32_t const* tradeDates,
+            int32_t lag,
+            _Out_writes_(count) int32_t* settlementDates,
+            size_t count
+            ) const;
+
+    private:
+        bool TryAddBusinessDays(int32_t from, int32_t count, _Out_ int32_t* result) const;
+        uint32_t Rank(uint32_t index) const;
+        uint32_t Select(uint32_t rank) const;
+
+        std::wstring                        m_region;
+        int32_t                             m_firstYear;
+        int32_t                             m_firstDay;
+        uint32_t                            m_dayCount;
+        uint8_t                             m_weekendMask;
+        std::vector<std::array<uint64_t, 6>> m_holidays;    // One 366-bit set per year.
+        std::vector<uint64_t>               m_business;     // One bit per covered day, plus a zero pad word.
+        std::vector<uint32_t>               m_rank;         // Business days before each word.
+    };
+}
@@ -0,0 +1,259 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "pch.h"
+#include "CalendarMetrics.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+using namespace winrt;
+using namespace winrt::SDKTemplate::CalendarEngine;
+
+namespace
+{
+    const uint32_t SubBucketBits = 2;
+    const uint32_t SubBucketCount = 1 << SubBucketBits;
+    const uint64_t MaxRecorded = (1ull << (LatencyHistogram::BucketCount / SubBucketCount + 1)) - 1;
+
+    inline uint32_t HighestBit(uint64_t value) noexcept
+    {
+        uint32_t bit = 0;
+        while (value >>= 1)
+        {
+            bit++;
+        }
+        return bit;
+    }
+
+#if CALENDAR_ENGINE_METRICS
+    // Written only by its own thread, so plain load/store pairs are enough; the atomics
+    // only make the concurrent reads by a snapshot well defined.
+    struct ThreadMetrics
+    {
+        ThreadMetrics();
+        ~ThreadMetrics();
+
+        std::atomic<uint64_t> buckets[OperationCount][LatencyHistogram::BucketCount];
+        std::atomic<uint64_t> nanoseconds[OperationCount];
+        std::atomic<uint64_t> counters[CounterCount];
+    };
+
+    inline void Bump(std::atomic<uint64_t>& value, uint64_t amount) noexcept
+    {
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    struct MetricsRegistry
+    {
+        std::mutex                   lock;
+        std::vector<ThreadMetrics*>  threads;
+        CalendarMetricsSnapshot      exited{};      // Totals of threads that have ended.
+    };
+
+    // Never destroyed, so threads that end during shutdown can still check out.
+    MetricsRegistry& Registry()
+    {
+        static MetricsRegistry* registry = new MetricsRegistry();
+        return *registry;
+    }
+
+    void AddThread(ThreadMetrics const& metrics, CalendarMetricsSnapshot& snapshot)
+    {
+        for (uint32_t operation = 0; operation < OperationCount; operation++)
+        {
+            LatencyHistogram& histogram = snapshot.operations[operation];
+            for (uint32_t bucket = 0; bucket < LatencyHistogram::BucketCount; bucket++)
+            {
+                uint64_t count = metrics.buckets[operation][bucket].load(std::memory_order_relaxed);
+                histogram.buckets[bucket] += count;
+                histogram.count += count;
+            }
+            histogram.totalNanoseconds += metrics.nanoseconds[operation].load(std::memory_order_relaxed);
+        }
+        for (uint32_t counter = 0; counter < CounterCount; counter++)
+        {
+            snapshot.counters[counter] += metrics.counters[counter].load(std::memory_order_relaxed);
+        }
+    }
+
+    ThreadMetrics::ThreadMetrics()
+    {
+        MetricsRegistry& registry = Registry();
+        std::lock_guard<std::mutex> lock(registry.lock);
+        registry.threads.push_back(this);
+    }
+
+    ThreadMetrics::~ThreadMetrics()
+    {
+        MetricsRegistry& registry = Registry();
+        std::lock_guard<std::mutex> lock(registry.lock);
+        AddThread(*this, registry.exited);
+        registry.threads.erase(std::find(registry.threads.begin(), registry.threads.end(), this));
+    }
+
+    thread_local ThreadMetrics t_metrics;
+
+    inline int64_t Now() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+#endif
+}
+
+uint32_t LatencyHistogram::BucketOf(uint64_t nanoseconds) noexcept
+{
+    if (nanoseconds < SubBucketCount)
+    {
+        return static_cast<uint32_t>(nanoseconds);
+    }
+    if (nanoseconds > MaxRecorded)
+    {
+        nanoseconds = MaxRecorded;
+    }
+    uint32_t octave = HighestBit(nanoseconds);
+    uint32_t step = static_cast<uint32_t>(nanoseconds >> (octave - SubBucketBits)) & (SubBucketCount - 1);
+    return (octave - SubBucketBits + 1) * SubBucketCount + step;
+}
+
+uint64_t LatencyHistogram::BucketLowerBound(uint32_t bucket) noexcept
+{
+    if (bucket < SubBucketCount)
+    {
+        return bucket;
+    }
+    uint32_t shift = bucket / SubBucketCount - 1;
+    return static_cast<uint64_t>(SubBucketCount + bucket % SubBucketCount) << shift;
+}
+
+uint64_t LatencyHistogram::Percentile(double fraction) const noexcept
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(fraction * static_cast<double>(count));
+    target = (target < 1) ? 1 : (target > count ? count : target);
+    uint64_t seen = 0;
+    for (uint32_t bucket = 0; bucket < BucketCount; bucket++)
+    {
+        seen += buckets[bucket];
+        if (seen >= target)
+        {
+            return BucketLowerBound(bucket);
+        }
+    }
+    return BucketLowerBound(BucketCount - 1);
+}
+
+char const* winrt::SDKTemplate::CalendarEngine::OperationName(CalendarOperation operation) noexcept
+{
+    static char const* const names[OperationCount] =
+    {
+        "add_units", "clone", "change_time_zone", "format", "zone_lookup", "zone_names_build",
+    };
+    return (operation < CalendarOperation::Count) ? names[static_cast<uint32_t>(operation)] : "unknown";
+}
+
+char const* winrt::SDKTemplate::CalendarEngine::CounterName(CalendarCounter counter) noexcept
+{
+    static char const* const names[CounterCount] =
+    {
+        "zone_name_cache_hit", "zone_name_cache_miss",
+    };
+    return (counter < CalendarCounter::Count) ? names[static_cast<uint32_t>(counter)] : "unknown";
+}
+
+CalendarMetricsSnapshot winrt::SDKTemplate::CalendarEngine::TakeMetricsSnapshot()
+{
+    CalendarMetricsSnapshot snapshot{};
+#if CALENDAR_ENGINE_METRICS
+    MetricsRegistry& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.lock);
+    snapshot = registry.exited;
+    for (ThreadMetrics const* metrics : registry.threads)
+    {
+        AddThread(*metrics, snapshot);
+    }
+#endif
+    return snapshot;
+}
+
+std::string winrt::SDKTemplate::CalendarEngine::FormatPrometheus(CalendarMetricsSnapshot const& snapshot)
+{
+    // Enough digits that every bound reads back as the same double; the default six
+    // would round le="0.001048575" to 0.00104858.
+    std::ostringstream text;
+    text << std::setprecision(std::numeric_limits<double>::max_digits10);
+    text << "# HELP calendar_operation_seconds Latency of calendar operations.\n";
+    text << "# TYPE calendar_operation_seconds histogram\n";
+    for (uint32_t operation = 0; operation < OperationCount; operation++)
+    {
+        LatencyHistogram const& histogram = snapshot.operations[operation];
+        char const* name = OperationName(static_cast<CalendarOperation>(operation));
+
+        // Each power of two starts a new group of buckets, so every group boundary is an
+        // exact bound: the calls below 2^k ns are the buckets before the group of 2^k.
+        // Samples are whole nanoseconds, so that is le="2^k - 1 ns".
+        uint64_t below = 0;
+        for (uint32_t bucket = 0; bucket < LatencyHistogram::BucketCount; bucket++)
+        {
+            if (bucket >= SubBucketCount && bucket % SubBucketCount == 0)
+            {
+                text << "calendar_operation_seconds_bucket{operation=\"" << name << "\",le=\"" <<
+                    static_cast<double>(LatencyHistogram::BucketLowerBound(bucket) - 1) / 1e9 << "\"} " << below << "\n";
+            }
+            below += histogram.buckets[bucket];
+        }
+        text << "calendar_operation_seconds_bucket{operation=\"" << name << "\",le=\"+Inf\"} " << histogram.count << "\n";
+        text << "calendar_operation_seconds_sum{operation=\"" << name << "\"} " << static_cast<double>(histogram.totalNanoseconds) / 1e9 << "\n";
+        text << "calendar_operation_seconds_count{operation=\"" << name << "\"} " << histogram.count << "\n";
+    }
+
+    text << "# HELP calendar_events_total Calendar engine events.\n";
+    text << "# TYPE calendar_events_total counter\n";
+    for (uint32_t counter = 0; counter < CounterCount; counter++)
+    {
+        text << "calendar_events_total{event=\"" << CounterName(static_cast<CalendarCounter>(counter)) << "\"} " << snapshot.counters[counter] << "\n";
+    }
+    return text.str();
+}
+
+#if CALENDAR_ENGINE_METRICS
+
+void winrt::SDKTemplate::CalendarEngine::RecordOperation(CalendarOperation operation, uint64_t nanoseconds) noexcept
+{
+    uint32_t index = static_cast<uint32_t>(operation);
+    Bump(t_metrics.buckets[index][LatencyHistogram::BucketOf(nanoseconds)], 1);
+    Bump(t_metrics.nanoseconds[index], nanoseconds);
+}
+
+void winrt::SDKTemplate::CalendarEngine::IncrementCounter(CalendarCounter counter) noexcept
+{
+    Bump(t_metrics.counters[static_cast<uint32_t>(counter)], 1);
+}
+
+ScopedOperationTimer::ScopedOperationTimer(CalendarOperation operation) noexcept :
+    m_operation(operation),
+    m_start(Now())
+{
+}
+
+ScopedOperationTimer::~ScopedOperationTimer()
+{
+    RecordOperation(m_operation, static_cast<uint64_t>(Now() - m_start));
+}
+
+#endif
@@ -0,0 +1,128 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+// CalendarMetrics:
+// Opt-in instrumentation for code that drives the calendar: a call count and latency
+// histogram per operation class, and plain event counters such as zone cache hits.
+//
+// Build with CALENDAR_ENGINE_METRICS=1 to enable it.  Otherwise the macros below expand
+// to the bare expression or to nothing, and TakeMetricsSnapshot returns zeros.
+//
+// Every thread records into its own block, so recording is a few unshared relaxed stores
+// with no lock prefix and no contended cache line.  A snapshot adds up all blocks, plus
+// what threads that have exited left behind; it may miss calls that are in flight.
+//
+// Latencies go into log-linear buckets: four linear steps per power of two nanoseconds,
+// so any value is within 25% of its bucket's lower bound, up to 2^41 ns (about 37 minutes).
+
+#include <array>
+#include <string>
+
+#ifndef CALENDAR_ENGINE_METRICS
+#define CALENDAR_ENGINE_METRICS 0
+#endif
+
+namespace winrt::SDKTemplate::CalendarEngine
+{
+    enum class CalendarOperation : uint32_t
+    {
+        AddUnits,           // Calendar::AddYears, AddDays, AddHours, ...
+        Clone,
+        ChangeTimeZone,
+        Format,             // DateTimeFormatter::Format
+        ZoneLookup,         // ZoneDatabase::Lookup
+        ZoneNamesBuild,     // ZoneDisplayNames construction
+        Count,
+    };
+
+    enum class CalendarCounter : uint32_t
+    {
+        ZoneNameCacheHit,
+        ZoneNameCacheMiss,
+        Count,
+    };
+
+    static const uint32_t OperationCount = static_cast<uint32_t>(CalendarOperation::Count);
+    static const uint32_t CounterCount = static_cast<uint32_t>(CalendarCounter::Count);
+
+    struct LatencyHistogram
+    {
+        static const uint32_t BucketCount = 160;
+
+        uint64_t                             count;
+        uint64_t                             totalNanoseconds;
+        std::array<uint64_t, BucketCount>    buckets;
+
+        static uint32_t BucketOf(uint64_t nanoseconds) noexcept;
+        static uint64_t BucketLowerBound(uint32_t bucket) noexcept;
+
+        // Lower bound of the bucket holding the given fraction (0..1) of the calls.
+        uint64_t Percentile(double fraction) const noexcept;
+    };
+
+    struct CalendarMetricsSnapshot
+    {
+        std::array<LatencyHistogram, OperationCount> operations;
+        std::array<uint64_t, CounterCount>           counters;
+    };
+
+    char const* OperationName(CalendarOperation operation) noexcept;
+    char const* CounterName(CalendarCounter counter) noexcept;
+
+    CalendarMetricsSnapshot TakeMetricsSnapshot();
+
+    // Prometheus text exposition format: one histogram family with an 'operation' label and
+    // one counter family with an 'event' label.  Histogram bounds are the powers of two.
+    std::string FormatPrometheus(CalendarMetricsSnapshot const& snapshot);
+
+#if CALENDAR_ENGINE_METRICS
+    void RecordOperation(CalendarOperation operation, uint64_t nanoseconds) noexcept;
+    void IncrementCounter(CalendarCounter counter) noexcept;
+
+    class ScopedOperationTimer
+    {
+    public:
+        explicit ScopedOperationTimer(CalendarOperation operation) noexcept;
+        ~ScopedOperationTimer();
+
+        ScopedOperationTimer(ScopedOperationTimer const&) = delete;
+        ScopedOperationTimer& operator=(ScopedOperationTimer const&) = delete;
+
+    private:
+        CalendarOperation m_operation;
+        int64_t           m_start;
+    };
+
+    template <typename Expression>
+    auto MeasureOperation(CalendarOperation operation, Expression&& expression)
+    {
+        ScopedOperationTimer timer(operation);
+        return expression();
+    }
+#endif
+}
+
+#if CALENDAR_ENGINE_METRICS
+// Times the rest of the enclosing scope.
+#define CALENDAR_ENGINE_TIME_SCOPE(operation) \
+    ::winrt::SDKTemplate::CalendarEngine::ScopedOperationTimer calendarEngineScopeTimer(operation)
+// Times one expression and yields its value.
+#define CALENDAR_ENGINE_MEASURE(operation, expression) \
+    ::winrt::SDKTemplate::CalendarEngine::MeasureOperation(operation, [&] { return (expression); })
+#define CALENDAR_ENGINE_COUNT(counter) \
+    ::winrt::SDKTemplate::CalendarEngine::IncrementCounter(counter)
+#else
+#define CALENDAR_ENGINE_TIME_SCOPE(operation) ((void)0)
+#define CALENDAR_ENGINE_MEASURE(operation, expression) (expression)
+#define CALENDAR_ENGINE_COUNT(counter) ((void)0)
+#endif
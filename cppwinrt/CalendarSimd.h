@@ -0,0 +1,22 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+// CalendarSimd:
+// The batch paths of the native calendar engine use SSE2, which every x64 and most x86
+// targets of this project guarantee.  ARM builds (and x86 builds without /arch:SSE2)
+// fall back to the scalar code, which must always produce identical results.
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CALENDAR_ENGINE_SSE2 1
+#include <emmintrin.h>
+#endif
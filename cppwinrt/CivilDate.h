@@ -0,0 +1,147 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+// CivilDate:
+// Proleptic Gregorian day arithmetic shared by the native calendar engine.
+// Dates are exchanged as a day number counted from 1 January 1970, which keeps
+// every range query a subtraction and lets batch code work on plain int32 columns.
+// Day of week follows Windows::Globalization::DayOfWeek (Sunday = 0).
+//
+// Everything here is constexpr, so fixed dates, epoch offsets and tables derived from
+// them are computed by the compiler and embedded as literals.
+
+#include <cstdint>
+
+namespace winrt::SDKTemplate::CalendarEngine
+{
+    // Written to the output of batch APIs for a date they cannot resolve.
+    constexpr int32_t InvalidDay = INT32_MIN;
+
+    struct CivilDate
+    {
+        int32_t year;
+        uint32_t month;     // 1..12
+        uint32_t day;       // 1..31
+    };
+
+    constexpr bool IsLeapYear(int32_t year) noexcept
+    {
+        return (year % 4 == 0) && ((year % 100 != 0) || (year % 400 == 0));
+    }
+
+    // 31 and 30 alternate, with the phase flipping at August.
+    constexpr uint32_t DaysInMonth(int32_t year, uint32_t month) noexcept
+    {
+        return (month == 2) ? (IsLeapYear(year) ? 29 : 28) : 30 + ((month + (month >> 3)) & 1);
+    }
+
+    constexpr uint32_t DaysInYear(int32_t year) noexcept
+    {
+        return IsLeapYear(year) ? 366 : 365;
+    }
+
+    // Day number of a civil date. Works on 400-year eras so the only branches are
+    // the floor divisions for negative years.
+    constexpr int32_t DaysFromCivil(int32_t year, uint32_t month, uint32_t day) noexcept
+    {
+        year -= (month <= 2) ? 1 : 0;
+        int32_t era = (year >= 0 ? year : year - 399) / 400;
+        uint32_t yearOfEra = static_cast<uint32_t>(year - era * 400);
+        uint32_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        uint32_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + static_cast<int32_t>(dayOfEra) - 719468;
+    }
+
+    constexpr int32_t DaysFromCivil(CivilDate const& date) noexcept
+    {
+        return DaysFromCivil(date.year, date.month, date.day);
+    }
+
+    constexpr CivilDate CivilFromDays(int32_t days) noexcept
+    {
+        days += 719468;
+        int32_t era = (days >= 0 ? days : days - 146096) / 146097;
+        uint32_t dayOfEra = static_cast<uint32_t>(days - era * 146097);
+        uint32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        uint32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        uint32_t monthPrime = (5 * dayOfYear + 2) / 153;
+        uint32_t day = dayOfYear - (153 * monthPrime + 2) / 5 + 1;
+        uint32_t month = monthPrime < 10 ? monthPrime + 3 : monthPrime - 9;
+        int32_t year = static_cast<int32_t>(yearOfEra) + era * 400 + (month <= 2 ? 1 : 0);
+        return { year, month, day };
+    }
+
+    // 1 January 1970 was a Thursday.
+    constexpr uint32_t WeekdayFromDays(int32_t days) noexcept
+    {
+        return static_cast<uint32_t>(days >= -4 ? (days + 4) % 7 : (days + 5) % 7 + 6);
+    }
+
+    // The proleptic Julian calendar, on the same day numbers.  It works like DaysFromCivil
+    // with 4-year eras in place of 400-year ones.
+    constexpr bool IsJulianLeapYear(int32_t year) noexcept
+    {
+        return year % 4 == 0;
+    }
+
+    constexpr int32_t DaysFromJulian(int32_t year, uint32_t month, uint32_t day) noexcept
+    {
+        year -= (month <= 2) ? 1 : 0;
+        int32_t era = (year >= 0 ? year : year - 3) / 4;
+        uint32_t yearOfEra = static_cast<uint32_t>(year - era * 4);
+        uint32_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        return era * 1461 + static_cast<int32_t>(yearOfEra * 365 + dayOfYear) - 719470;
+    }
+
+    constexpr CivilDate JulianFromDays(int32_t days) noexcept
+    {
+        days += 719470;
+        int32_t era = (days >= 0 ? days : days - 1460) / 1461;
+        uint32_t dayOfEra = static_cast<uint32_t>(days - era * 1461);
+        uint32_t yearOfEra = (dayOfEra - dayOfEra / 1460) / 365;
+        uint32_t dayOfYear = dayOfEra - 365 * yearOfEra;
+        uint32_t monthPrime = (5 * dayOfYear + 2) / 153;
+        uint32_t day = dayOfYear - (153 * monthPrime + 2) / 5 + 1;
+        uint32_t month = monthPrime < 10 ? monthPrime + 3 : monthPrime - 9;
+        int32_t year = static_cast<int32_t>(yearOfEra) + era * 4 + (month <= 2 ? 1 : 0);
+        return { year, month, day };
+    }
+
+    // Fixed-offset arithmetic: a civil date and time at UTC + offsetMinutes, as Unix
+    // seconds and as 100 ns ticks since 1601 (FILETIME and DateTime).
+    constexpr int64_t SecondsPerDay = 86400;
+    constexpr int64_t TicksPerSecond = 10000000;
+    constexpr int64_t UnixEpochSeconds1601 = -DaysFromCivil(1601, 1, 1) * SecondsPerDay;
+
+    constexpr int64_t UnixSecondsFromCivil(
+        int32_t year,
+        uint32_t month,
+        uint32_t day,
+        uint32_t hour,
+        uint32_t minute,
+        uint32_t second,
+        int32_t offsetMinutes = 0
+        ) noexcept
+    {
+        return DaysFromCivil(year, month, day) * SecondsPerDay + hour * 3600 + minute * 60 + second - offsetMinutes * 60;
+    }
+
+    constexpr int64_t TicksFromUnixSeconds(int64_t unixSeconds) noexcept
+    {
+        return (unixSeconds + UnixEpochSeconds1601) * TicksPerSecond;
+    }
+
+    static_assert(DaysFromCivil(1970, 1, 1) == 0 && WeekdayFromDays(0) == 4, "the epoch is a Thursday");
+    static_assert(DaysFromJulian(1582, 10, 4) + 1 == DaysFromCivil(1582, 10, 15), "the Gregorian reform");
+    static_assert(UnixEpochSeconds1601 == 11644473600, "FILETIME epoch");
+}
@@ -0,0 +1,183 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "pch.h"
+#include "DateTimeFields.h"
+#include "CalendarSimd.h"
+#include <cstring>
+
+using namespace winrt;
+using namespace winrt::SDKTemplate::CalendarEngine;
+
+namespace
+{
+    constexpr int32_t FirstValidDay = DaysFromCivil(1, 1, 1);
+    constexpr int32_t LastValidDay = DaysFromCivil(9999, 12, 31);
+
+    inline int64_t FloorDiv(int64_t value, int64_t divisor)
+    {
+        int64_t quotient = value / divisor;
+        return (value % divisor < 0) ? quotient - 1 : quotient;
+    }
+
+    inline bool IsValidRow(DateTimeColumns const& rows, size_t i) noexcept
+    {
+        int32_t year = rows.year[i];
+        int32_t month = rows.month[i];
+        return year >= 1 && year <= 9999 &&
+            month >= 1 && month <= 12 &&
+            rows.day[i] >= 1 && static_cast<uint32_t>(rows.day[i]) <= DaysInMonth(year, static_cast<uint32_t>(month)) &&
+            rows.hour[i] >= 0 && rows.hour[i] <= 23 &&
+            rows.minute[i] >= 0 && rows.minute[i] <= 59 &&
+            rows.second[i] >= 0 && rows.second[i] <= 59;
+    }
+
+    // Carries each field into the next larger one in 64 bits, then lets the day number
+    // absorb whatever is left of the day and month.
+    bool NormalizeRow(DateTimeColumns const& rows, size_t i) noexcept
+    {
+        int64_t second = rows.second[i];
+        int64_t minute = rows.minute[i] + FloorDiv(second, 60);
+        int64_t hour = rows.hour[i] + FloorDiv(minute, 60);
+        int64_t dayCarry = FloorDiv(hour, 24);
+        int64_t monthIndex = static_cast<int64_t>(rows.month[i]) - 1;
+        int64_t year = rows.year[i] + FloorDiv(monthIndex, 12);
+        if (year < -1000000 || year > 1000000)
+        {
+            return false;
+        }
+
+        uint32_t month = static_cast<uint32_t>(monthIndex - FloorDiv(monthIndex, 12) * 12) + 1;
+        int64_t days = DaysFromCivil(static_cast<int32_t>(year), month, 1) + (static_cast<int64_t>(rows.day[i]) - 1) + dayCarry;
+        if (days < FirstValidDay || days > LastValidDay)
+        {
+            return false;
+        }
+
+        CivilDate date = CivilFromDays(static_cast<int32_t>(days));
+        rows.year[i] = date.year;
+        rows.month[i] = static_cast<int32_t>(date.month);
+        rows.day[i] = static_cast<int32_t>(date.day);
+        rows.hour[i] = static_cast<int32_t>(hour - dayCarry * 24);
+        rows.minute[i] = static_cast<int32_t>(minute - FloorDiv(minute, 60) * 60);
+        rows.second[i] = static_cast<int32_t>(second - FloorDiv(second, 60) * 60);
+        return true;
+    }
+
+#ifdef CALENDAR_ENGINE_SSE2
+    inline __m128i Load(int32_t const* column, size_t i)
+    {
+        return _mm_loadu_si128(reinterpret_cast<__m128i const*>(column + i));
+    }
+
+    // All ones in the lanes where value is outside [low, high].
+    inline __m128i Outside(__m128i value, int32_t low, int32_t high)
+    {
+        return _mm_or_si128(_mm_cmplt_epi32(value, _mm_set1_epi32(low)), _mm_cmpgt_epi32(value, _mm_set1_epi32(high)));
+    }
+
+    // SSE2 has no 32-bit lane multiply; build it from the two 32 x 32 -> 64 ones.
+    inline __m128i MultiplyLow(__m128i left, __m128i right)
+    {
+        __m128i even = _mm_mul_epu32(left, right);
+        __m128i odd = _mm_mul_epu32(_mm_srli_epi64(left, 32), _mm_srli_epi64(right, 32));
+        return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    }
+
+    // Bit k set if row i + k is invalid.
+    inline uint32_t InvalidRows(DateTimeColumns const& rows, size_t i)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i one = _mm_set1_epi32(1);
+        __m128i year = Load(rows.year, i);
+        __m128i month = Load(rows.month, i);
+        __m128i day = Load(rows.day, i);
+
+        // A year is a multiple of 100 if it is one of 4 and of 25, and of 400 if it is also
+        // one of 16.  Divisibility by 25 is a multiply by its inverse modulo 2^32 followed
+        // by an unsigned compare against (2^32 - 1) / 25.
+        const __m128i sign = _mm_set1_epi32(INT32_MIN);
+        __m128i byFour = _mm_cmpeq_epi32(_mm_and_si128(year, _mm_set1_epi32(3)), zero);
+        __m128i bySixteen = _mm_cmpeq_epi32(_mm_and_si128(year, _mm_set1_epi32(15)), zero);
+        __m128i scaled = _mm_xor_si128(MultiplyLow(year, _mm_set1_epi32(static_cast<int32_t>(0xC28F5C29))), sign);
+        __m128i byTwentyFive = _mm_cmplt_epi32(scaled, _mm_xor_si128(_mm_set1_epi32(171798691), sign));
+        __m128i leap = _mm_and_si128(byFour, _mm_or_si128(_mm_andnot_si128(byTwentyFive, _mm_set1_epi32(-1)), bySixteen));
+
+        // Month lengths as in DaysInMonth: 30 or 31 by parity, February 28 plus leap.
+        __m128i length = _mm_add_epi32(_mm_set1_epi32(30), _mm_and_si128(_mm_add_epi32(month, _mm_srli_epi32(month, 3)), one));
+        __m128i february = _mm_cmpeq_epi32(month, _mm_set1_epi32(2));
+        __m128i februaryLength = _mm_sub_epi32(_mm_set1_epi32(28), leap);
+        length = _mm_or_si128(_mm_andnot_si128(february, length), _mm_and_si128(february, februaryLength));
+
+        __m128i invalid = Outside(year, 1, 9999);
+        invalid = _mm_or_si128(invalid, Outside(month, 1, 12));
+        invalid = _mm_or_si128(invalid, _mm_or_si128(_mm_cmplt_epi32(day, one), _mm_cmpgt_epi32(day, length)));
+        invalid = _mm_or_si128(invalid, Outside(Load(rows.hour, i), 0, 23));
+        invalid = _mm_or_si128(invalid, Outside(Load(rows.minute, i), 0, 59));
+        invalid = _mm_or_si128(invalid, Outside(Load(rows.second, i), 0, 59));
+        return static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(invalid)));
+    }
+#endif
+
+    // Runs 'repair' on every invalid row and marks the rows it returns false for.
+    template <typename Repair>
+    size_t ScanRows(DateTimeColumns const& rows, uint64_t* failures, size_t count, Repair&& repair) noexcept
+    {
+        std::memset(failures, 0, (count + 63) / 64 * sizeof(uint64_t));
+        size_t failed = 0;
+        size_t i = 0;
+
+#ifdef CALENDAR_ENGINE_SSE2
+        for (; i + 4 <= count; i += 4)
+        {
+            uint32_t invalid = InvalidRows(rows, i);
+            while (invalid != 0)
+            {
+                uint32_t lane = (invalid & 1) ? 0 : (invalid & 2) ? 1 : (invalid & 4) ? 2 : 3;
+                invalid &= invalid - 1;
+                if (!repair(i + lane))
+                {
+                    failures[(i + lane) / 64] |= 1ull << ((i + lane) % 64);
+                    failed++;
+                }
+            }
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            if (!IsValidRow(rows, i) && !repair(i))
+            {
+                failures[i / 64] |= 1ull << (i % 64);
+                failed++;
+            }
+        }
+        return failed;
+    }
+}
+
+size_t winrt::SDKTemplate::CalendarEngine::ValidateDateTimes(
+    DateTimeColumns const& rows,
+    _Out_writes_((count + 63) / 64) uint64_t* failures,
+    size_t count
+    ) noexcept
+{
+    return ScanRows(rows, failures, count, [](size_t) { return false; });
+}
+
+size_t winrt::SDKTemplate::CalendarEngine::NormalizeDateTimes(
+    DateTimeColumns const& rows,
+    _Out_writes_((count + 63) / 64) uint64_t* failures,
+    size_t count
+    ) noexcept
+{
+    return ScanRows(rows, failures, count, [&rows](size_t i) { return NormalizeRow(rows, i); });
+}
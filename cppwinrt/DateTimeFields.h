@@ -0,0 +1,60 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+// DateTimeFields:
+// Validation and normalization of user-entered date and time fields at volume.
+//
+// Setting fields one at a time on a calendar depends on the order: setting day 31 before
+// month 4 is rejected, after it the day is clamped or rolled.  These functions look at
+// whole rows (year, month, day, hour, minute, second) instead.  Rows are passed as one
+// column per field so that four rows fill one SSE2 register per field.
+//
+// Validation checks every field of four rows at once without branches, leap years
+// included.  Normalization rolls out-of-range fields over into the next larger one, the
+// way a lenient calendar does (second 75 is 1:15, day 0 is the last day of the previous
+// month, month 13 is January of the next year); rows that are already valid are found by
+// the same SIMD pass and left alone.
+//
+// Neither throws.  Rows that fail are reported in a bitmap, bit i % 64 of word i / 64 for
+// row i, and counted.
+
+#include "CivilDate.h"
+
+namespace winrt::SDKTemplate::CalendarEngine
+{
+    // Every column holds 'count' values.  Valid rows are years 1..9999, seconds 0..59.
+    struct DateTimeColumns
+    {
+        int32_t* year;
+        int32_t* month;
+        int32_t* day;
+        int32_t* hour;
+        int32_t* minute;
+        int32_t* second;
+    };
+
+    // Marks the rows that are not a valid date and time.  The columns are not modified.
+    size_t ValidateDateTimes(
+        DateTimeColumns const& rows,
+        _Out_writes_((count + 63) / 64) uint64_t* failures,
+        size_t count
+        ) noexcept;
+
+    // Rolls every row over to a valid date and time in place.  Rows whose result falls
+    // outside years 1..9999 are marked and left unchanged.
+    size_t NormalizeDateTimes(
+        DateTimeColumns const& rows,
+        _Out_writes_((count + 63) / 64) uint64_t* failures,
+        size_t count
+        ) noexcept;
+}
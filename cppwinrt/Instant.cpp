@@ -0,0 +1,270 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "pch.h"
+#include "Instant.h"
+#include "CivilDate.h"
+#include "CalendarSimd.h"
+
+using namespace winrt;
+using namespace winrt::SDKTemplate::CalendarEngine;
+
+namespace
+{
+    const int64_t NanosecondsPerSecond = 1000000000;
+    const int64_t NanosecondsPerTick = 100;
+
+    // Valid over the whole int64_t range, unlike the (value - divisor + 1) form.
+    inline int64_t FloorDiv(int64_t value, int64_t divisor)
+    {
+        int64_t quotient = value / divisor;
+        return (value % divisor < 0) ? quotient - 1 : quotient;
+    }
+
+    inline bool AddOverflows(int64_t left, int64_t right, _Out_ int64_t* sum)
+    {
+        if ((right > 0 && left > INT64_MAX - right) || (right < 0 && left < INT64_MIN - right))
+        {
+            return true;
+        }
+        *sum = left + right;
+        return false;
+    }
+
+    inline bool SubtractOverflows(int64_t left, int64_t right, _Out_ int64_t* difference)
+    {
+        if ((right < 0 && left > INT64_MAX + right) || (right > 0 && left < INT64_MIN + right))
+        {
+            return true;
+        }
+        *difference = left - right;
+        return false;
+    }
+
+    // Splits a signed nanosecond count into whole seconds (rounded down) and 0..999999999.
+    inline void SplitNanoseconds(int64_t nanoseconds, _Out_ int64_t* seconds, _Out_ uint32_t* remainder)
+    {
+        *seconds = FloorDiv(nanoseconds, NanosecondsPerSecond);
+        *remainder = static_cast<uint32_t>(nanoseconds - *seconds * NanosecondsPerSecond);
+    }
+}
+
+bool winrt::SDKTemplate::CalendarEngine::CheckedAdd(Instant instant, int64_t nanoseconds, _Out_ Instant* result) noexcept
+{
+    int64_t seconds;
+    uint32_t remainder;
+    SplitNanoseconds(nanoseconds, &seconds, &remainder);
+
+    uint32_t sum = instant.nanoseconds + remainder;
+    if (sum >= NanosecondsPerSecond)
+    {
+        sum -= NanosecondsPerSecond;
+        seconds++;          // At most 9223372037, so this cannot overflow.
+    }
+    int64_t total;
+    if (AddOverflows(instant.seconds, seconds, &total))
+    {
+        return false;
+    }
+    *result = { total, sum, 0 };
+    return true;
+}
+
+Instant winrt::SDKTemplate::CalendarEngine::SaturatingAdd(Instant instant, int64_t nanoseconds) noexcept
+{
+    Instant result;
+    if (!CheckedAdd(instant, nanoseconds, &result))
+    {
+        return (nanoseconds > 0) ? MaxInstant : MinInstant;
+    }
+    return result;
+}
+
+bool winrt::SDKTemplate::CalendarEngine::CheckedDifference(Instant later, Instant earlier, _Out_ int64_t* nanoseconds) noexcept
+{
+    int64_t seconds;
+    if (SubtractOverflows(later.seconds, earlier.seconds, &seconds))
+    {
+        return false;
+    }
+
+    // Give both parts the same sign so that only the final sum can overflow.
+    int64_t fraction = static_cast<int64_t>(later.nanoseconds) - earlier.nanoseconds;
+    if (seconds > 0 && fraction < 0)
+    {
+        seconds--;
+        fraction += NanosecondsPerSecond;
+    }
+    else if (seconds < 0 && fraction > 0)
+    {
+        seconds++;
+        fraction -= NanosecondsPerSecond;
+    }
+
+    const int64_t limit = INT64_MAX / NanosecondsPerSecond;
+    if (seconds > limit || seconds < -limit)
+    {
+        return false;
+    }
+    int64_t whole = seconds * NanosecondsPerSecond;
+    int64_t total;
+    if (AddOverflows(whole, fraction, &total))
+    {
+        return false;
+    }
+    *nanoseconds = total;
+    return true;
+}
+
+int64_t winrt::SDKTemplate::CalendarEngine::SaturatingDifference(Instant later, Instant earlier) noexcept
+{
+    int64_t nanoseconds;
+    if (!CheckedDifference(later, earlier, &nanoseconds))
+    {
+        return (earlier < later) ? INT64_MAX : INT64_MIN;
+    }
+    return nanoseconds;
+}
+
+Instant winrt::SDKTemplate::CalendarEngine::InstantFromTicks(int64_t ticks) noexcept
+{
+    int64_t seconds = FloorDiv(ticks, TicksPerSecond);
+    uint32_t nanoseconds = static_cast<uint32_t>((ticks - seconds * TicksPerSecond) * NanosecondsPerTick);
+    return { seconds - UnixEpochSeconds1601, nanoseconds, 0 };
+}
+
+ConversionLoss winrt::SDKTemplate::CalendarEngine::TicksFromInstant(Instant instant, _Out_ int64_t* ticks) noexcept
+{
+    int64_t seconds;
+    int64_t fraction = instant.nanoseconds / NanosecondsPerTick;
+    bool overflow = AddOverflows(instant.seconds, UnixEpochSeconds1601, &seconds);
+    if (!overflow)
+    {
+        if (seconds >= 0)
+        {
+            overflow = seconds > INT64_MAX / TicksPerSecond ||
+                (seconds == INT64_MAX / TicksPerSecond && fraction > INT64_MAX % TicksPerSecond);
+        }
+        else
+        {
+            // Borrow one second so that the fraction is negative too: -4 s + 0.3 s = -3 s - 0.7 s.
+            seconds++;
+            fraction -= TicksPerSecond;
+            overflow = seconds < INT64_MIN / TicksPerSecond ||
+                (seconds == INT64_MIN / TicksPerSecond && fraction < INT64_MIN % TicksPerSecond);
+        }
+    }
+    if (overflow)
+    {
+        *ticks = (instant.seconds > 0) ? INT64_MAX : INT64_MIN;
+        return ConversionLoss::Saturated;
+    }
+
+    *ticks = seconds * TicksPerSecond + fraction;
+    return (instant.nanoseconds % NanosecondsPerTick != 0) ? ConversionLoss::Truncated : ConversionLoss::None;
+}
+
+Instant winrt::SDKTemplate::CalendarEngine::InstantFromFileTime(FILETIME const& fileTime) noexcept
+{
+    // FILETIME is unsigned, so split it before it can be mistaken for a negative tick count.
+    uint64_t ticks = (static_cast<uint64_t>(fileTime.dwHighDateTime) << 32) | fileTime.dwLowDateTime;
+    int64_t seconds = static_cast<int64_t>(ticks / TicksPerSecond);
+    uint32_t nanoseconds = static_cast<uint32_t>((ticks % TicksPerSecond) * NanosecondsPerTick);
+    return { seconds - UnixEpochSeconds1601, nanoseconds, 0 };
+}
+
+ConversionLoss winrt::SDKTemplate::CalendarEngine::FileTimeFromInstant(Instant instant, _Out_ FILETIME* fileTime) noexcept
+{
+    int64_t ticks;
+    ConversionLoss loss = TicksFromInstant(instant, &ticks);
+    if (ticks < 0)
+    {
+        ticks = 0;
+        loss = ConversionLoss::Saturated;
+    }
+    fileTime->dwLowDateTime = static_cast<DWORD>(ticks);
+    fileTime->dwHighDateTime = static_cast<DWORD>(static_cast<uint64_t>(ticks) >> 32);
+    return loss;
+}
+
+Instant winrt::SDKTemplate::CalendarEngine::InstantFromDateTime(Windows::Foundation::DateTime dateTime) noexcept
+{
+    return InstantFromTicks(dateTime.time_since_epoch().count());
+}
+
+ConversionLoss winrt::SDKTemplate::CalendarEngine::DateTimeFromInstant(Instant instant, _Out_ Windows::Foundation::DateTime* dateTime) noexcept
+{
+    int64_t ticks;
+    ConversionLoss loss = TicksFromInstant(instant, &ticks);
+    *dateTime = Windows::Foundation::DateTime(Windows::Foundation::TimeSpan(ticks));
+    return loss;
+}
+
+void winrt::SDKTemplate::CalendarEngine::SaturatingAdd(
+    _In_reads_(count) Instant const* instants,
+    int64_t nanoseconds,
+    _Out_writes_(count) Instant* results,
+    size_t count
+    ) noexcept
+{
+    int64_t seconds;
+    uint32_t remainder;
+    SplitNanoseconds(nanoseconds, &seconds, &remainder);
+    size_t i = 0;
+
+#ifdef CALENDAR_ENGINE_SSE2
+    // One instant per register: the low quadword is seconds, the high one nanoseconds.
+    // The nanosecond sum stays below 2^31, so a single 64-bit add handles both lanes and
+    // the carry is a signed 32-bit compare.
+    __m128i addend = _mm_set_epi64x(remainder, seconds);
+    __m128i secondLimit = _mm_set_epi32(0, static_cast<int>(NanosecondsPerSecond - 1), 0, 0);
+    __m128i secondMask = _mm_set_epi32(0, static_cast<int>(NanosecondsPerSecond), 0, 0);
+    __m128i lowQuad = _mm_set_epi32(0, 0, -1, -1);
+    for (; i < count; i++)
+    {
+        __m128i value = _mm_load_si128(reinterpret_cast<__m128i const*>(instants + i));
+        __m128i sum = _mm_add_epi64(value, addend);
+        __m128i carry = _mm_cmpgt_epi32(sum, secondLimit);
+        carry = _mm_shuffle_epi32(carry, _MM_SHUFFLE(2, 2, 2, 2));
+        sum = _mm_sub_epi32(sum, _mm_and_si128(carry, secondMask));
+        sum = _mm_sub_epi64(sum, _mm_and_si128(carry, lowQuad));
+
+        // Signed overflow of the seconds: the result's sign differs from both inputs'.
+        __m128i step = _mm_sub_epi64(addend, _mm_and_si128(carry, lowQuad));
+        __m128i overflow = _mm_and_si128(_mm_xor_si128(value, sum), _mm_xor_si128(step, sum));
+        if (_mm_movemask_epi8(overflow) & 0x80)
+        {
+            results[i] = (seconds >= 0) ? MaxInstant : MinInstant;
+            continue;
+        }
+        _mm_store_si128(reinterpret_cast<__m128i*>(results + i), sum);
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        results[i] = SaturatingAdd(instants[i], nanoseconds);
+    }
+}
+
+size_t winrt::SDKTemplate::CalendarEngine::TicksFromInstants(
+    _In_reads_(count) Instant const* instants,
+    _Out_writes_(count) int64_t* ticks,
+    size_t count
+    ) noexcept
+{
+    size_t lossy = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        lossy += (TicksFromInstant(instants[i], &ticks[i]) != ConversionLoss::None) ? 1 : 0;
+    }
+    return lossy;
+}
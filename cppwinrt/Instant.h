@@ -0,0 +1,94 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+// Instant:
+// A UTC instant with nanosecond precision: 64-bit Unix seconds and a 32-bit nanosecond
+// field, padded to 16 bytes so that one instant fills one SSE register and an array of
+// them can be processed without unaligned loads.  The range is about +/-292 billion years,
+// so unlike DateTime (100 ns ticks in 64 bits, +/-29 000 years) arithmetic far from the
+// epoch cannot silently wrap.
+//
+// Arithmetic comes in two flavors: Checked* returns false on overflow and leaves the
+// result untouched; Saturating* clamps to MinInstant / MaxInstant (or INT64_MIN /
+// INT64_MAX nanoseconds).  Conversions to 100 ns ticks report whether they truncated
+// sub-tick nanoseconds or had to clamp; conversions from ticks are always exact.
+//
+// Every function expects normalized instants (nanoseconds below one billion).
+
+namespace winrt::SDKTemplate::CalendarEngine
+{
+    struct alignas(16) Instant
+    {
+        int64_t  seconds;           // UTC seconds since 1970-01-01T00:00:00Z.
+        uint32_t nanoseconds;       // 0..999999999
+        uint32_t reserved;          // Zero.
+    };
+    static_assert(sizeof(Instant) == 16, "Instant is laid out for SIMD batches");
+
+    static const Instant MinInstant = { INT64_MIN, 0, 0 };
+    static const Instant MaxInstant = { INT64_MAX, 999999999, 0 };
+
+    inline bool operator==(Instant const& left, Instant const& right)
+    {
+        return left.seconds == right.seconds && left.nanoseconds == right.nanoseconds;
+    }
+
+    inline bool operator!=(Instant const& left, Instant const& right)
+    {
+        return !(left == right);
+    }
+
+    inline bool operator<(Instant const& left, Instant const& right)
+    {
+        return left.seconds < right.seconds || (left.seconds == right.seconds && left.nanoseconds < right.nanoseconds);
+    }
+
+    enum class ConversionLoss
+    {
+        None,
+        Truncated,          // Nanoseconds below the target's resolution were dropped (rounded down).
+        Saturated,          // The instant is outside the target's range; the nearest end was returned.
+    };
+
+    bool CheckedAdd(Instant instant, int64_t nanoseconds, _Out_ Instant* result) noexcept;
+    Instant SaturatingAdd(Instant instant, int64_t nanoseconds) noexcept;
+
+    // later - earlier, in nanoseconds.
+    bool CheckedDifference(Instant later, Instant earlier, _Out_ int64_t* nanoseconds) noexcept;
+    int64_t SaturatingDifference(Instant later, Instant earlier) noexcept;
+
+    // Ticks are 100 ns units since 1601-01-01T00:00:00Z, as used by FILETIME and DateTime.
+    Instant InstantFromTicks(int64_t ticks) noexcept;
+    ConversionLoss TicksFromInstant(Instant instant, _Out_ int64_t* ticks) noexcept;
+
+    Instant InstantFromFileTime(FILETIME const& fileTime) noexcept;
+    ConversionLoss FileTimeFromInstant(Instant instant, _Out_ FILETIME* fileTime) noexcept;   // Saturates at 1601.
+
+    Instant InstantFromDateTime(Windows::Foundation::DateTime dateTime) noexcept;
+    ConversionLoss DateTimeFromInstant(Instant instant, _Out_ Windows::Foundation::DateTime* dateTime) noexcept;
+
+    // Batch forms for columns of instants, e.g. exchange timestamps.  They never fail:
+    // results saturate, and the conversion returns how many rows lost information.
+    void SaturatingAdd(
+        _In_reads_(count) Instant const* instants,
+        int64_t nanoseconds,
+        _Out_writes_(count) Instant* results,
+        size_t count
+        ) noexcept;
+
+    size_t TicksFromInstants(
+        _In_reads_(count) Instant const* instants,
+        _Out_writes_(count) int64_t* ticks,
+        size_t count
+        ) noexcept;
+}
@@ -0,0 +1,61 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+// JapaneseEra:
+// The modern Japanese eras, from Meiji on, with the Gregorian day each one began, as in
+// the Japanese calendar of Windows::Globalization.  The table is constexpr, so the era
+// of a constant date folds to a literal, and a new era is one more line.
+
+#include "CivilDate.h"
+
+namespace winrt::SDKTemplate::CalendarEngine
+{
+    struct JapaneseEra
+    {
+        wchar_t const*  name;
+        int32_t         firstDay;
+    };
+
+    constexpr JapaneseEra JapaneseEras[] =
+    {
+        { L"Meiji",  DaysFromCivil(1868, 9, 8) },
+        { L"Taisho", DaysFromCivil(1912, 7, 30) },
+        { L"Showa",  DaysFromCivil(1926, 12, 25) },
+        { L"Heisei", DaysFromCivil(1989, 1, 8) },
+        { L"Reiwa",  DaysFromCivil(2019, 5, 1) },
+    };
+
+    constexpr uint32_t JapaneseEraCount = sizeof(JapaneseEras) / sizeof(JapaneseEras[0]);
+
+    // Index into JapaneseEras of the era holding 'days'; JapaneseEraCount before Meiji.
+    constexpr uint32_t JapaneseEraOf(int32_t days) noexcept
+    {
+        for (uint32_t era = JapaneseEraCount; era-- > 0;)
+        {
+            if (days >= JapaneseEras[era].firstDay)
+            {
+                return era;
+            }
+        }
+        return JapaneseEraCount;
+    }
+
+    // Year within the era; the Gregorian year in which the era began is year 1.
+    constexpr int32_t JapaneseEraYear(int32_t days, uint32_t era) noexcept
+    {
+        return CivilFromDays(days).year - CivilFromDays(JapaneseEras[era].firstDay).year + 1;
+    }
+
+    static_assert(JapaneseEraOf(DaysFromCivil(2019, 4, 30)) == 3 && JapaneseEraOf(DaysFromCivil(2019, 5, 1)) == 4, "Heisei ends on 30 April 2019");
+    static_assert(JapaneseEraYear(DaysFromCivil(1989, 1, 7), 2) == 64, "Showa 64");
+}
@@ -0,0 +1,312 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "pch.h"
+#include "LunisolarCalendar.h"
+
+using namespace winrt;
+using namespace winrt::SDKTemplate::CalendarEngine;
+
+namespace
+{
+    // One word per lunar year, 1900 first; see LunisolarCalendar.h for the layout.
+    // Chinese months are reckoned at 120 degrees east.
+    const uint32_t ChineseYears[] =
+    {
+        0x1716D2, 0x3C0752, 0x260EA5, 0x12B64A, 0x36064B, 0x1E0A9B, 0x0A9556, 0x30056A,
+        0x1A0B59, 0x045752, 0x2A0752, 0x14DB25, 0x3A0B25, 0x220A4B, 0x0CB4AB, 0x3202AD,
+        0x1C056B, 0x066B69, 0x2C0DA9, 0x18FD92, 0x3E0E92, 0x260D25, 0x10DA4D, 0x360A56,
+        0x2002B6, 0x0895B5, 0x3006D4, 0x1A0EA9, 0x065E92, 0x2A0E92, 0x14CD26, 0x38052B,
+        0x220A57, 0x0CB2B6, 0x320B5A, 0x1E06D4, 0x086EC9, 0x2C0749, 0x16F693, 0x3C0A93,
+        0x26052B, 0x0ECA5B, 0x340AAD, 0x20056A, 0x0A9B55, 0x300BA4, 0x1A0B49, 0x045A93,
+        0x2A0A95, 0x12F52D, 0x380536, 0x220AAD, 0x0EB5AA, 0x320DB2, 0x1E0DA4, 0x087D49,
+        0x2E0D4A, 0x170A95, 0x3A0A97, 0x260556, 0x10CAB5, 0x340AD5, 0x2006D2, 0x0A8EA5,
+        0x300EA5, 0x1A064A, 0x026C97, 0x280A9B, 0x14F55A, 0x38056A, 0x220B69, 0x0EB752,
+        0x340B52, 0x1C0B25, 0x06964B, 0x2C0A4B, 0x1714AB, 0x3A02AD, 0x24056D, 0x10CB69,
+        0x360DA9, 0x200D92, 0x0A9D25, 0x300D25, 0x1B5A4D, 0x3E0A56, 0x2802B6, 0x12E5B5,
+        0x3806D5, 0x220EA9, 0x0EBE92, 0x340E92, 0x1E0D26, 0x066A56, 0x2A0A57, 0x1714D6,
+        0x3C035A, 0x2406D5, 0x10AEC9, 0x360749, 0x200693, 0x08952B, 0x2E052B, 0x180A5B,
+        0x04555A, 0x28056A, 0x12FB55, 0x3A0BA4, 0x240B49, 0x0CBA93, 0x320A95, 0x1C052D,
+        0x068A6D, 0x2A0AB5, 0x1735AA, 0x3C05D2, 0x260DA5, 0x10DD4A, 0x360E4A, 0x200C95,
+        0x0A952E, 0x2E0556, 0x180AB5, 0x0455B2, 0x2A06D2, 0x12CEA5, 0x380F25, 0x24064A,
+        0x0CAC97, 0x3004AB, 0x1A055B, 0x066AD6, 0x2C0B69, 0x177752, 0x3C0B52, 0x260B25,
+        0x10DA4B, 0x340A4B, 0x1E04AB, 0x08A55B, 0x2E05AD, 0x180B6A, 0x045B52, 0x2A0D92,
+        0x14FD25, 0x380D25, 0x220A55, 0x0CB4AD, 0x3204B6, 0x1A05B5, 0x066DAA, 0x2C0EC9,
+        0x191E92, 0x3C0E92, 0x260D26, 0x10CA56, 0x340A57, 0x1E04D6, 0x0886D5, 0x2E0755,
+        0x1A0749, 0x026E93, 0x280693, 0x12F52B, 0x38052B, 0x200A5B, 0x0CB55A, 0x32056A,
+        0x1C0B65, 0x06974A, 0x2C0B49, 0x171A95, 0x3C0A95, 0x24052D, 0x0ECAAD, 0x340AB5,
+        0x2005AA, 0x088BA5, 0x2E0DA5, 0x1A0D4A, 0x047C95, 0x280C96, 0x12F94E, 0x380556,
+        0x220AB5, 0x0CB5B2, 0x3206D2, 0x1C0EA5, 0x088E4A, 0x2A068B, 0x150C97, 0x3A04AB,
+        0x24055B, 0x0ECAD6, 0x340B6A, 0x200752, 0x0A9725, 0x2E0B45, 0x180A8B, 0x02549B,
+        0x2804AB,
+    };
+
+    // Korean months are reckoned at the meridian of the Korean standard time in force at
+    // the time (UTC+8:30 or UTC+9 for most of the range).
+    const uint32_t KoreanYears[] =
+    {
+        0x1716D2, 0x3C0752, 0x260EA5, 0x12B64A, 0x36064B, 0x1E0A9B, 0x0A9556, 0x30056A,
+        0x1A0B59, 0x045752, 0x2A0752, 0x14DB25, 0x3A0B25, 0x220A4B, 0x0CB29B, 0x320AAD,
+        0x1E056A, 0x064B69, 0x2C0BA9, 0x18FB52, 0x3E0D92, 0x260D25, 0x10BA4D, 0x360956,
+        0x2002B5, 0x0895AD, 0x3006D4, 0x1A0DA9, 0x065D92, 0x2A0E92, 0x14CD26, 0x380527,
+        0x220A57, 0x0CB2B6, 0x320ADA, 0x1E06D4, 0x086EA9, 0x2C0749, 0x16F693, 0x3C0A93,
+        0x26052B, 0x0ECA5B, 0x34096D, 0x200B6A, 0x0C9B54, 0x300BA4, 0x1A0B49, 0x045A93,
+        0x2A0A95, 0x12F52B, 0x38052D, 0x220AAD, 0x0EB56A, 0x320DB2, 0x1E0DA4, 0x087D49,
+        0x2E0D4A, 0x171A95, 0x3C0A96, 0x260556, 0x10CAB5, 0x340AD5, 0x2006D2, 0x0A8EA5,
+        0x300EA5, 0x1A0E4A, 0x046C96, 0x280A9B, 0x14F556, 0x38056A, 0x220B59, 0x0EB752,
+        0x340752, 0x1C0725, 0x06964B, 0x2C0A4B, 0x1712AB, 0x3A02AD, 0x24056B, 0x10CB69,
+        0x360DA9, 0x200D92, 0x0A9B25, 0x300D25, 0x1B5A4D, 0x3E0A56, 0x2802B6, 0x12D5AD,
+        0x3A06D4, 0x220DA9, 0x0EBD92, 0x340E92, 0x1E0D26, 0x066A56, 0x2A0A57, 0x1712B6,
+        0x3C0B5A, 0x2606D4, 0x10AEC9, 0x360749, 0x200693, 0x089527, 0x2E052B, 0x180A5B,
+        0x04555A, 0x28036A, 0x12FB55, 0x3A0BA4, 0x240B49, 0x0CBA93, 0x320A95, 0x1C052D,
+        0x066A5D, 0x2A0AAD, 0x1735AA, 0x3C05D2, 0x260DA5, 0x10BD49, 0x360D4A, 0x200A95,
+        0x0A952D, 0x2E0556, 0x180AB5, 0x0455AA, 0x2A06D2, 0x12CEA5, 0x380EA5, 0x240E4A,
+        0x0EAC96, 0x300C9B, 0x1C055A, 0x066AD5, 0x2C0B69, 0x177752, 0x3C0752, 0x260B25,
+        0x10D64B, 0x340A4B, 0x1E04AB, 0x08A55B, 0x2E056D, 0x180B69, 0x045B52, 0x2A0D92,
+        0x14FD25, 0x380D25, 0x220A4D, 0x0CB4AD, 0x3202B6, 0x1A05B5, 0x066DA9, 0x2C0DC9,
+        0x191D92, 0x3C0E92, 0x260D26, 0x10CA56, 0x340A57, 0x1E04D6, 0x0886B5, 0x2E06D5,
+        0x1A0EC9, 0x046E92, 0x280693, 0x12F52B, 0x38052B, 0x200A5B, 0x0CB55A, 0x32056A,
+        0x1C0B55, 0x069749, 0x2C0B49, 0x171A93, 0x3C0A95, 0x24052D, 0x0ECAAD, 0x340AB5,
+        0x2005AA, 0x088BA5, 0x2E0DA5, 0x1A0D4A, 0x047A95, 0x280C95, 0x12F52E, 0x380556,
+        0x220AB5, 0x0CB5B2, 0x3206D2, 0x1C0EA5, 0x089E4A, 0x2C064A, 0x150C97, 0x3A0CAB,
+        0x26055A, 0x0ECAD5, 0x340B69, 0x200752, 0x0A8EA5, 0x2E0B25, 0x18064B, 0x027497,
+        0x2804AB,
+    };
+
+    static_assert(sizeof(ChineseYears) / sizeof(ChineseYears[0]) == LunisolarCalendar::LastYear - LunisolarCalendar::FirstYear + 1, "one word per year");
+    static_assert(sizeof(KoreanYears) / sizeof(KoreanYears[0]) == LunisolarCalendar::LastYear - LunisolarCalendar::FirstYear + 1, "one word per year");
+
+    inline uint32_t PopCount32(uint32_t value) noexcept
+    {
+        value = value - ((value >> 1) & 0x55555555u);
+        value = (value & 0x33333333u) + ((value >> 2) & 0x33333333u);
+        value = (value + (value >> 4)) & 0x0F0F0F0Fu;
+        return (value * 0x01010101u) >> 24;
+    }
+
+    inline uint32_t LeapMonthOf(uint32_t info) noexcept
+    {
+        return (info >> 13) & 0xF;
+    }
+
+    inline uint32_t MonthCountOf(uint32_t info) noexcept
+    {
+        return (LeapMonthOf(info) != 0) ? 13 : 12;
+    }
+
+    inline int32_t NewYearOf(int32_t year, uint32_t info) noexcept
+    {
+        return DaysFromCivil(year, 1, 20) + static_cast<int32_t>((info >> 17) & 0x3F);
+    }
+
+    // Days from the new year to the start of the index-th month in sequence (0 based).
+    inline uint32_t MonthOffset(uint32_t info, uint32_t index) noexcept
+    {
+        return 29 * index + PopCount32(info & ((1u << index) - 1));
+    }
+}
+
+LunisolarCalendar::LunisolarCalendar(_In_reads_(LastYear - FirstYear + 1) uint32_t const* years) :
+    m_years(years)
+{
+}
+
+LunisolarCalendar const& LunisolarCalendar::Chinese()
+{
+    static const LunisolarCalendar calendar(ChineseYears);
+    return calendar;
+}
+
+LunisolarCalendar const& LunisolarCalendar::Korean()
+{
+    static const LunisolarCalendar calendar(KoreanYears);
+    return calendar;
+}
+
+uint32_t LunisolarCalendar::YearInfo(int32_t year) const
+{
+    if (year < FirstYear || year > LastYear)
+    {
+        throw hresult_out_of_bounds();
+    }
+    return m_years[year - FirstYear];
+}
+
+int32_t LunisolarCalendar::LastDay() const
+{
+    return NewYear(LastYear) + static_cast<int32_t>(DaysInYear(LastYear)) - 1;
+}
+
+int32_t LunisolarCalendar::NewYear(int32_t year) const
+{
+    return NewYearOf(year, YearInfo(year));
+}
+
+uint32_t LunisolarCalendar::MonthsInYear(int32_t year) const
+{
+    return MonthCountOf(YearInfo(year));
+}
+
+uint32_t LunisolarCalendar::LeapMonth(int32_t year) const
+{
+    return LeapMonthOf(YearInfo(year));
+}
+
+uint32_t LunisolarCalendar::DaysInYear(int32_t year) const
+{
+    uint32_t info = YearInfo(year);
+    return MonthOffset(info, MonthCountOf(info));
+}
+
+uint32_t LunisolarCalendar::MonthIndex(uint32_t info, uint32_t month, bool isLeapMonth) const
+{
+    uint32_t leapMonth = LeapMonthOf(info);
+    if (month < 1 || month > 12 || (isLeapMonth && month != leapMonth))
+    {
+        throw hresult_invalid_argument();
+    }
+    // The leap month sits right after the month whose number it repeats.
+    return (isLeapMonth || (leapMonth != 0 && month > leapMonth)) ? month : month - 1;
+}
+
+uint32_t LunisolarCalendar::DaysInMonth(int32_t year, uint32_t month, bool isLeapMonth) const
+{
+    uint32_t info = YearInfo(year);
+    return 29 + ((info >> MonthIndex(info, month, isLeapMonth)) & 1);
+}
+
+int32_t LunisolarCalendar::MonthStart(int32_t year, uint32_t month, bool isLeapMonth) const
+{
+    uint32_t info = YearInfo(year);
+    return NewYearOf(year, info) + static_cast<int32_t>(MonthOffset(info, MonthIndex(info, month, isLeapMonth)));
+}
+
+int32_t LunisolarCalendar::ToDays(LunisolarDate const& date) const
+{
+    if (date.year < FirstYear || date.year > LastYear || date.day < 1 || date.day > DaysInMonth(date.year, date.month, date.isLeapMonth))
+    {
+        throw hresult_invalid_argument();
+    }
+    return MonthStart(date.year, date.month, date.isLeapMonth) + static_cast<int32_t>(date.day) - 1;
+}
+
+bool LunisolarCalendar::TryLunarYear(int32_t day, _Out_ int32_t* year) const
+{
+    // The lunar year starts in January or February, so it is the Gregorian year or the one before.
+    int32_t candidate = CivilFromDays(day).year;
+    if (candidate < FirstYear || candidate > LastYear + 1)
+    {
+        return false;
+    }
+    if (candidate == LastYear + 1 || day < NewYearOf(candidate, m_years[candidate - FirstYear]))
+    {
+        candidate--;
+    }
+    if (candidate < FirstYear)
+    {
+        return false;
+    }
+    uint32_t info = m_years[candidate - FirstYear];
+    if (static_cast<uint32_t>(day - NewYearOf(candidate, info)) >= MonthOffset(info, MonthCountOf(info)))
+    {
+        return false;
+    }
+    *year = candidate;
+    return true;
+}
+
+LunisolarDate LunisolarCalendar::FromDays(int32_t day) const
+{
+    int32_t year;
+    if (!TryLunarYear(day, &year))
+    {
+        throw hresult_out_of_bounds();
+    }
+
+    uint32_t info = m_years[year - FirstYear];
+    uint32_t offset = static_cast<uint32_t>(day - NewYearOf(year, info));
+    uint32_t count = MonthCountOf(info);
+
+    // Months are 29 or 30 days long, so offset / 30 is at most one month short.
+    uint32_t index = offset / 30;
+    while (index + 1 < count && MonthOffset(info, index + 1) <= offset)
+    {
+        index++;
+    }
+
+    uint32_t leapMonth = LeapMonthOf(info);
+    LunisolarDate date;
+    date.year = year;
+    date.isLeapMonth = (leapMonth != 0 && index == leapMonth);
+    date.month = (leapMonth != 0 && index >= leapMonth) ? index : index + 1;
+    date.day = offset - MonthOffset(info, index) + 1;
+    return date;
+}
+
+uint32_t LunisolarCalendar::CycleYear(int32_t year) noexcept
+{
+    int32_t position = (year - 1984) % 60;
+    return static_cast<uint32_t>(position < 0 ? position + 60 : position) + 1;
+}
+
+size_t LunisolarCalendar::FromDays(
+    _In_reads_(count) int32_t const* days,
+    _Out_writes_(count) LunisolarDate* dates,
+    size_t count
+    ) const
+{
+    int32_t first = FirstDay();
+    int32_t last = LastDay();
+    size_t failures = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (days[i] < first || days[i] > last)
+        {
+            dates[i] = { InvalidDay, 0, false, 0 };
+            failures++;
+            continue;
+        }
+        dates[i] = FromDays(days[i]);
+    }
+    return failures;
+}
+
+size_t LunisolarCalendar::LunarYears(
+    _In_reads_(count) int32_t const* days,
+    _Out_writes_(count) int32_t* years,
+    size_t count
+    ) const
+{
+    // [yearStart, yearEnd) is the lunar year found last.
+    int32_t year = InvalidDay;
+    int32_t yearStart = 0;
+    int32_t yearEnd = 0;
+    size_t failures = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        int32_t day = days[i];
+        if (day < yearStart || day >= yearEnd)
+        {
+            if (!TryLunarYear(day, &year))
+            {
+                years[i] = InvalidDay;
+                failures++;
+                yearStart = yearEnd = 0;
+                continue;
+            }
+            uint32_t info = m_years[year - FirstYear];
+            yearStart = NewYearOf(year, info);
+            yearEnd = yearStart + static_cast<int32_t>(MonthOffset(info, MonthCountOf(info)));
+        }
+        years[i] = year;
+    }
+    return failures;
+}
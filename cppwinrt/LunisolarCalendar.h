@@ -0,0 +1,99 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+// LunisolarCalendar:
+// The Chinese and Korean (Dangi) lunisolar calendars for the lunar years that begin in
+// 1900 through 2100, without astronomy at run time.
+//
+// A lunar month starts on the day of a new moon, and a leap month is inserted in a year
+// with thirteen new moons, at the first month that contains no principal solar term.
+// Both calendars follow those rules; they differ only in the meridian used to decide on
+// which day a new moon falls, so their tables diverge in some months.  The new moons and
+// solar terms were computed offline and reduced to one 32-bit word per lunar year:
+//
+//     bits  0..12   month lengths in sequence, 1 = 30 days, 0 = 29 days
+//     bits 13..16   number of the month that is followed by a leap month, 0 if none
+//     bits 17..22   days from 20 January of the Gregorian year to the lunar new year
+//
+// The start of month k of a year is the new year plus 29 * k plus the number of 30-day
+// months before it, so every conversion is a few table reads and a popcount.
+//
+// Lunar years are named by the Gregorian year in which they begin.  The sexagenary
+// cycle name is available from CycleYear.
+
+#include "CivilDate.h"
+
+namespace winrt::SDKTemplate::CalendarEngine
+{
+    struct LunisolarDate
+    {
+        int32_t  year;          // Gregorian year of the lunar new year.
+        uint32_t month;         // 1..12
+        bool     isLeapMonth;   // The leap month repeats the number of the month before it.
+        uint32_t day;           // 1..30
+    };
+
+    class LunisolarCalendar
+    {
+    public:
+        static const int32_t FirstYear = 1900;
+        static const int32_t LastYear = 2100;
+
+        static LunisolarCalendar const& Chinese();
+        static LunisolarCalendar const& Korean();
+
+        int32_t FirstDay() const { return NewYear(FirstYear); }
+        int32_t LastDay() const;
+
+        // Per-year facts; throw hresult_out_of_bounds outside [FirstYear, LastYear].
+        int32_t NewYear(int32_t year) const;
+        uint32_t MonthsInYear(int32_t year) const;
+        uint32_t LeapMonth(int32_t year) const;          // 0 when the year has no leap month.
+        uint32_t DaysInYear(int32_t year) const;
+
+        // Throws hresult_invalid_argument for a month or day that does not exist.
+        uint32_t DaysInMonth(int32_t year, uint32_t month, bool isLeapMonth) const;
+        int32_t MonthStart(int32_t year, uint32_t month, bool isLeapMonth) const;
+        int32_t ToDays(LunisolarDate const& date) const;
+
+        // Throws hresult_out_of_bounds outside [FirstDay(), LastDay()].
+        LunisolarDate FromDays(int32_t day) const;
+
+        // Position 1..60 in the sexagenary cycle; 1 (jiazi) for 1984.
+        static uint32_t CycleYear(int32_t year) noexcept;
+
+        // Batch forms.  Days outside the calendar are written as year InvalidDay and counted.
+        size_t FromDays(
+            _In_reads_(count) int32_t const* days,
+            _Out_writes_(count) LunisolarDate* dates,
+            size_t count
+            ) const;
+
+        // Lunar year of every day, for grouping by lunar year.  Consecutive days in the same
+        // year, as in a sorted column, cost one compare each.
+        size_t LunarYears(
+            _In_reads_(count) int32_t const* days,
+            _Out_writes_(count) int32_t* years,
+            size_t count
+            ) const;
+
+    private:
+        explicit LunisolarCalendar(_In_reads_(LastYear - FirstYear + 1) uint32_t const* years);
+
+        uint32_t YearInfo(int32_t year) const;
+        bool TryLunarYear(int32_t day, _Out_ int32_t* year) const;
+        uint32_t MonthIndex(uint32_t info, uint32_t month, bool isLeapMonth) const;
+
+        uint32_t const* m_years;
+    };
+}
@@ -0,0 +1,54 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "pch.h"
+#include "MappedFile.h"
+
+using namespace winrt;
+using namespace winrt::SDKTemplate::CalendarEngine;
+
+MappedFile::MappedFile(std::wstring const& path)
+{
+    m_file.attach(CreateFile2(path.c_str(), GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, nullptr));
+    if (!m_file)
+    {
+        throw_last_error();
+    }
+
+    FILE_STANDARD_INFO info;
+    check_bool(GetFileInformationByHandleEx(m_file.get(), FileStandardInfo, &info, sizeof(info)));
+    m_size = static_cast<size_t>(info.EndOfFile.QuadPart);
+    if (m_size == 0)
+    {
+        // Empty files cannot be mapped; Data() stays null.
+        return;
+    }
+
+    m_mapping.attach(CreateFileMappingFromApp(m_file.get(), nullptr, PAGE_READONLY, 0, nullptr));
+    if (!m_mapping)
+    {
+        throw_last_error();
+    }
+
+    m_view = MapViewOfFileFromApp(m_mapping.get(), FILE_MAP_READ, 0, 0);
+    if (m_view == nullptr)
+    {
+        throw_last_error();
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_view != nullptr)
+    {
+        UnmapViewOfFile(m_view);
+    }
+}
@@ -0,0 +1,39 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+// MappedFile:
+// Read-only view of a whole file, mapped with the app-container friendly
+// CreateFileMappingFromApp / MapViewOfFileFromApp APIs.  Pages are faulted in
+// only when they are touched, so readers that skip blocks never read them.
+
+namespace winrt::SDKTemplate::CalendarEngine
+{
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(std::wstring const& path);
+        ~MappedFile();
+
+        MappedFile(MappedFile const&) = delete;
+        MappedFile& operator=(MappedFile const&) = delete;
+
+        void const* Data() const { return m_view; }
+        size_t Size() const { return m_size; }
+
+    private:
+        file_handle m_file;
+        handle      m_mapping;
+        void*       m_view = nullptr;
+        size_t      m_size = 0;
+    };
+}
@@ -0,0 +1,167 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "pch.h"
+#include "MonthGrid.h"
+#include "LunisolarCalendar.h"
+#include "PersianCalendar.h"
+
+using namespace winrt;
+using namespace winrt::SDKTemplate::CalendarEngine;
+
+namespace
+{
+    struct MonthSpan
+    {
+        int32_t  start;
+        uint32_t length;
+    };
+
+    MonthSpan GregorianMonth(int32_t year, uint32_t month)
+    {
+        if (month < 1 || month > 12)
+        {
+            throw hresult_invalid_argument();
+        }
+        return { DaysFromCivil(year, month, 1), DaysInMonth(year, month) };
+    }
+
+    MonthSpan LunisolarMonth(LunisolarCalendar const& calendar, int32_t year, uint32_t ordinal)
+    {
+        uint32_t count = calendar.MonthsInYear(year);
+        if (ordinal < 1 || ordinal > count)
+        {
+            throw hresult_invalid_argument();
+        }
+
+        // Ordinals count the leap month, which follows the month whose number it repeats.
+        uint32_t leapMonth = calendar.LeapMonth(year);
+        uint32_t month = (leapMonth != 0 && ordinal > leapMonth) ? ordinal - 1 : ordinal;
+        bool isLeapMonth = (leapMonth != 0 && ordinal == leapMonth + 1);
+        return { calendar.MonthStart(year, month, isLeapMonth), calendar.DaysInMonth(year, month, isLeapMonth) };
+    }
+
+    MonthSpan PersianMonth(int32_t year, uint32_t month)
+    {
+        uint32_t length = DaysInPersianMonth(year, month);
+        return { DaysFromPersian({ year, month, 1 }), length };
+    }
+
+    MonthSpan Month(CalendarSystem system, int32_t year, uint32_t month)
+    {
+        switch (system)
+        {
+        case CalendarSystem::Gregorian:
+            return GregorianMonth(year, month);
+        case CalendarSystem::Chinese:
+            return LunisolarMonth(LunisolarCalendar::Chinese(), year, month);
+        case CalendarSystem::Korean:
+            return LunisolarMonth(LunisolarCalendar::Korean(), year, month);
+        case CalendarSystem::Persian:
+            return PersianMonth(year, month);
+        default:
+            throw hresult_invalid_argument();
+        }
+    }
+
+    uint32_t MonthsInYear(CalendarSystem system, int32_t year)
+    {
+        switch (system)
+        {
+        case CalendarSystem::Chinese:
+            return LunisolarCalendar::Chinese().MonthsInYear(year);
+        case CalendarSystem::Korean:
+            return LunisolarCalendar::Korean().MonthsInYear(year);
+        default:
+            return 12;
+        }
+    }
+}
+
+MonthGrid winrt::SDKTemplate::CalendarEngine::BuildMonthGrid(CalendarSystem system, int32_t year, uint32_t month, uint32_t firstDayOfWeek)
+{
+    if (firstDayOfWeek > 6)
+    {
+        throw hresult_invalid_argument();
+    }
+
+    MonthSpan current = Month(system, year, month);
+    MonthGrid grid;
+    grid.firstCell = (WeekdayFromDays(current.start) + 7 - firstDayOfWeek) % 7;
+    grid.firstDay = current.start - static_cast<int32_t>(grid.firstCell);
+    grid.daysInMonth = current.length;
+
+    uint32_t previousLength = 0;
+    if (grid.firstCell != 0)
+    {
+        previousLength = (month > 1) ? Month(system, year, month - 1).length : Month(system, year - 1, MonthsInYear(system, year - 1)).length;
+    }
+
+    // Three runs of consecutive numbers: the previous month's tail, this month, the next month's head.
+    uint32_t cell = 0;
+    for (uint32_t day = previousLength - grid.firstCell + 1; cell < grid.firstCell; cell++, day++)
+    {
+        grid.dayOfMonth[cell] = static_cast<uint8_t>(day);
+    }
+    for (uint32_t day = 1; day <= current.length; cell++, day++)
+    {
+        grid.dayOfMonth[cell] = static_cast<uint8_t>(day);
+    }
+    for (uint32_t day = 1; cell < MonthGrid::CellCount; cell++, day++)
+    {
+        grid.dayOfMonth[cell] = static_cast<uint8_t>(day);
+    }
+    return grid;
+}
+
+MonthGridCache::MonthGridCache(size_t capacity) :
+    m_capacity(capacity)
+{
+    if (capacity == 0)
+    {
+        throw hresult_invalid_argument();
+    }
+}
+
+MonthGrid const& MonthGridCache::Get(CalendarSystem system, int32_t year, uint32_t month, uint32_t firstDayOfWeek)
+{
+    // The key keeps 8 bits of each; anything wider is no month or weekday and must not
+    // alias a cached grid.  BuildMonthGrid checks the rest on a miss.
+    if (month > 0xFF || firstDayOfWeek > 6)
+    {
+        throw hresult_invalid_argument();
+    }
+
+    uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(year)) << 32) |
+        (static_cast<uint64_t>(system) << 16) |
+        (month << 8) |
+        firstDayOfWeek;
+
+    auto found = m_index.find(key);
+    if (found != m_index.end())
+    {
+        m_hits++;
+        m_entries.splice(m_entries.begin(), m_entries, found->second);
+        return found->second->grid;
+    }
+
+    // Build first so that a bad request leaves the cache untouched.
+    m_misses++;
+    MonthGrid grid = BuildMonthGrid(system, year, month, firstDayOfWeek);
+    if (m_entries.size() == m_capacity)
+    {
+        m_index.erase(m_entries.back().key);
+        m_entries.pop_back();
+    }
+    m_entries.push_front({ key, grid });
+    m_index.emplace(key, m_entries.begin());
+    return m_entries.front().grid;
+}
@@ -0,0 +1,83 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+// MonthGrid:
+// The 6 x 7 block of days a month view shows: the month itself plus the tail of the
+// previous month and the head of the next one, starting on a chosen first day of week.
+// A grid needs only the month's first day, its length and the previous month's length,
+// all of which come straight from the engine's calendar tables.
+//
+// Months are numbered by their ordinal within the year.  For the lunisolar calendars
+// that counts the leap month, so a year may have 13 of them.
+//
+// MonthGridCache keeps the most recently used grids so that a view scrolling back and
+// forth over the same months does not rebuild them.
+
+#include <array>
+#include <list>
+#include <unordered_map>
+#include "CivilDate.h"
+
+namespace winrt::SDKTemplate::CalendarEngine
+{
+    enum class CalendarSystem
+    {
+        Gregorian,
+        Chinese,
+        Korean,
+        Persian,
+    };
+
+    struct MonthGrid
+    {
+        static const uint32_t CellCount = 42;
+
+        int32_t                         firstDay;       // Day number of cell 0; cell i is firstDay + i.
+        uint32_t                        firstCell;      // Cell of the month's first day.
+        uint32_t                        daysInMonth;
+        std::array<uint8_t, CellCount>  dayOfMonth;     // As printed in each cell.
+
+        bool InMonth(uint32_t cell) const { return cell - firstCell < daysInMonth; }
+    };
+
+    // firstDayOfWeek follows DayOfWeek (Sunday = 0).  Throws hresult_invalid_argument for a
+    // month that does not exist and hresult_out_of_bounds for a year the calendar does not
+    // cover, including the year before a grid's leading days.
+    MonthGrid BuildMonthGrid(CalendarSystem system, int32_t year, uint32_t month, uint32_t firstDayOfWeek);
+
+    // Not thread safe; each view keeps its own cache.
+    class MonthGridCache
+    {
+    public:
+        explicit MonthGridCache(size_t capacity);
+
+        // The reference stays valid until the next call.
+        MonthGrid const& Get(CalendarSystem system, int32_t year, uint32_t month, uint32_t firstDayOfWeek);
+
+        size_t Hits() const { return m_hits; }
+        size_t Misses() const { return m_misses; }
+
+    private:
+        struct Entry
+        {
+            uint64_t  key;
+            MonthGrid grid;
+        };
+
+        size_t                                                   m_capacity;
+        std::list<Entry>                                         m_entries;     // Most recently used first.
+        std::unordered_map<uint64_t, std::list<Entry>::iterator> m_index;
+        size_t                                                   m_hits = 0;
+        size_t                                                   m_misses = 0;
+    };
+}
@@ -0,0 +1,218 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "pch.h"
+#include "PersianCalendar.h"
+
+using namespace winrt;
+using namespace winrt::SDKTemplate::CalendarEngine;
+
+namespace
+{
+    // Bit i is set if year PersianFirstYear + i is a leap year.
+    const uint32_t LeapYears[] =
+    {
+        0x08888888, 0x11111111, 0x22222222, 0x44444444, 0x88888888,
+        0x11111110, 0x22222221, 0x44444442, 0x88888884, 0x11111108,
+        0x22222211, 0x44444422, 0x88888844, 0x11111088, 0x00000011,
+    };
+
+    // Leap years before each word of LeapYears.
+    const uint16_t LeapYearsBefore[] =
+    {
+        0, 7, 15, 23, 31, 39, 46, 54, 62, 70, 77, 85, 93, 101, 108, 110,
+    };
+
+    static_assert(sizeof(LeapYears) * 8 >= PersianLastYear - PersianFirstYear + 1, "one bit per year");
+
+    constexpr int32_t FirstNewYear = DaysFromCivil(1799, 3, 21);    // 1 Farvardin 1178.
+    const int32_t DaysPerCycle = 12053;             // 33 years, 8 of them leap.
+
+    inline uint32_t PopCount32(uint32_t value) noexcept
+    {
+        value = value - ((value >> 1) & 0x55555555u);
+        value = (value & 0x33333333u) + ((value >> 2) & 0x33333333u);
+        value = (value + (value >> 4)) & 0x0F0F0F0Fu;
+        return (value * 0x01010101u) >> 24;
+    }
+
+    inline bool IsLeap(uint32_t index) noexcept
+    {
+        return (LeapYears[index / 32] >> (index % 32)) & 1;
+    }
+
+    // Start of the year with the given index; index may be one past the last year.
+    inline int32_t NewYearOf(uint32_t index) noexcept
+    {
+        uint32_t leaps = LeapYearsBefore[index / 32] + PopCount32(LeapYears[index / 32] & ((1u << (index % 32)) - 1));
+        return FirstNewYear + static_cast<int32_t>(365 * index + leaps);
+    }
+
+    inline uint32_t MonthStartOf(uint32_t month) noexcept
+    {
+        return (month <= 7) ? 31 * (month - 1) : 30 * (month - 1) + 6;
+    }
+
+    inline bool TryYearIndex(int32_t year, _Out_ uint32_t* index) noexcept
+    {
+        if (year < PersianFirstYear || year > PersianLastYear)
+        {
+            return false;
+        }
+        *index = static_cast<uint32_t>(year - PersianFirstYear);
+        return true;
+    }
+
+    bool TryDaysFromPersian(PersianDate const& date, _Out_ int32_t* days) noexcept
+    {
+        uint32_t index;
+        if (!TryYearIndex(date.year, &index) || date.month < 1 || date.month > 12 || date.day < 1)
+        {
+            return false;
+        }
+        uint32_t length = (date.month <= 6) ? 31 : (date.month <= 11 || IsLeap(index)) ? 30 : 29;
+        if (date.day > length)
+        {
+            return false;
+        }
+        *days = NewYearOf(index) + static_cast<int32_t>(MonthStartOf(date.month) + date.day - 1);
+        return true;
+    }
+
+    bool TryPersianFromDays(int32_t days, _Out_ PersianDate* date) noexcept
+    {
+        if (days < FirstNewYear || days > PersianLastDay())
+        {
+            return false;
+        }
+
+        // The mean year is exact over a 33-year cycle, so the estimate is off by at most one.
+        uint32_t index = static_cast<uint32_t>(static_cast<int64_t>(days - FirstNewYear) * 33 / DaysPerCycle);
+        int32_t newYear = NewYearOf(index);
+        if (newYear > days)
+        {
+            newYear = NewYearOf(--index);
+        }
+        else if (index < PersianLastYear - PersianFirstYear && NewYearOf(index + 1) <= days)
+        {
+            newYear = NewYearOf(++index);
+        }
+
+        uint32_t dayOfYear = static_cast<uint32_t>(days - newYear);
+        uint32_t month = (dayOfYear < 186) ? dayOfYear / 31 + 1 : (dayOfYear - 186) / 30 + 7;
+        *date = { PersianFirstYear + static_cast<int32_t>(index), month, dayOfYear - MonthStartOf(month) + 1 };
+        return true;
+    }
+}
+
+int32_t winrt::SDKTemplate::CalendarEngine::PersianFirstDay() noexcept
+{
+    return FirstNewYear;
+}
+
+int32_t winrt::SDKTemplate::CalendarEngine::PersianLastDay() noexcept
+{
+    return NewYearOf(PersianLastYear - PersianFirstYear + 1) - 1;
+}
+
+bool winrt::SDKTemplate::CalendarEngine::IsPersianLeapYear(int32_t year)
+{
+    uint32_t index;
+    if (!TryYearIndex(year, &index))
+    {
+        throw hresult_out_of_bounds();
+    }
+    return IsLeap(index);
+}
+
+int32_t winrt::SDKTemplate::CalendarEngine::PersianNewYear(int32_t year)
+{
+    uint32_t index;
+    if (!TryYearIndex(year, &index))
+    {
+        throw hresult_out_of_bounds();
+    }
+    return NewYearOf(index);
+}
+
+uint32_t winrt::SDKTemplate::CalendarEngine::DaysInPersianMonth(int32_t year, uint32_t month)
+{
+    if (month < 1 || month > 12)
+    {
+        throw hresult_invalid_argument();
+    }
+    if (month <= 6)
+    {
+        return 31;
+    }
+    return (month <= 11 || IsPersianLeapYear(year)) ? 30 : 29;
+}
+
+int32_t winrt::SDKTemplate::CalendarEngine::DaysFromPersian(PersianDate const& date)
+{
+    int32_t days;
+    if (!TryDaysFromPersian(date, &days))
+    {
+        uint32_t index;
+        if (!TryYearIndex(date.year, &index))
+        {
+            throw hresult_out_of_bounds();
+        }
+        throw hresult_invalid_argument();
+    }
+    return days;
+}
+
+PersianDate winrt::SDKTemplate::CalendarEngine::PersianFromDays(int32_t days)
+{
+    PersianDate date;
+    if (!TryPersianFromDays(days, &date))
+    {
+        throw hresult_out_of_bounds();
+    }
+    return date;
+}
+
+size_t winrt::SDKTemplate::CalendarEngine::PersianFromDays(
+    _In_reads_(count) int32_t const* days,
+    _Out_writes_(count) PersianDate* dates,
+    size_t count
+    ) noexcept
+{
+    size_t failures = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!TryPersianFromDays(days[i], &dates[i]))
+        {
+            dates[i] = { InvalidDay, 0, 0 };
+            failures++;
+        }
+    }
+    return failures;
+}
+
+size_t winrt::SDKTemplate::CalendarEngine::DaysFromPersian(
+    _In_reads_(count) PersianDate const* dates,
+    _Out_writes_(count) int32_t* days,
+    size_t count
+    ) noexcept
+{
+    size_t failures = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!TryDaysFromPersian(dates[i], &days[i]))
+        {
+            days[i] = InvalidDay;
+            failures++;
+        }
+    }
+    return failures;
+}
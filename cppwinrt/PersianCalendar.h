@@ -0,0 +1,67 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+// PersianCalendar:
+// The Solar Hijri calendar used in Iran (the default calendar for fa-IR) for the years
+// 1178 through 1633 AP, that is from March 1799 to March 2255.
+//
+// The year starts on the day of the March equinox if the equinox falls before noon
+// Tehran time (UTC+3:30), else on the next day.  The first six months have 31 days, the
+// next five 30, and Esfand has 29, or 30 in a leap year.  Leap years were found offline
+// from the equinox instants and stored as one bit per year, with the number of leap years
+// before every 32-year word, so the start of any year is one multiply, one table read
+// and one popcount.  Over this range the table happens to agree with the 33-year
+// arithmetic rule; outside it the two drift apart, which is why the range is closed.
+
+#include "CivilDate.h"
+
+namespace winrt::SDKTemplate::CalendarEngine
+{
+    struct PersianDate
+    {
+        int32_t  year;
+        uint32_t month;     // 1..12, Farvardin = 1.
+        uint32_t day;       // 1..31
+    };
+
+    static const int32_t PersianFirstYear = 1178;
+    static const int32_t PersianLastYear = 1633;
+
+    int32_t PersianFirstDay() noexcept;
+    int32_t PersianLastDay() noexcept;
+
+    // Throw hresult_out_of_bounds outside [PersianFirstYear, PersianLastYear].
+    bool IsPersianLeapYear(int32_t year);
+    int32_t PersianNewYear(int32_t year);
+
+    // Throw hresult_invalid_argument for a month or day that does not exist.
+    uint32_t DaysInPersianMonth(int32_t year, uint32_t month);
+    int32_t DaysFromPersian(PersianDate const& date);
+
+    // Throws hresult_out_of_bounds outside [PersianFirstDay(), PersianLastDay()].
+    PersianDate PersianFromDays(int32_t days);
+
+    // Batch forms.  Rows that cannot be converted are written as InvalidDay (the year
+    // field for PersianFromDays) and counted.
+    size_t PersianFromDays(
+        _In_reads_(count) int32_t const* days,
+        _Out_writes_(count) PersianDate* dates,
+        size_t count
+        ) noexcept;
+
+    size_t DaysFromPersian(
+        _In_reads_(count) PersianDate const* dates,
+        _Out_writes_(count) int32_t* days,
+        size_t count
+        ) noexcept;
+}
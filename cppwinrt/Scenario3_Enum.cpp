@@ -12,12 +12,16 @@
 #include "pch.h"
 #include "Scenario3_Enum.h"
 #include "Scenario3_Enum.g.cpp"
+#include "CalendarMetrics.h"
+#include "CivilDate.h"
+#include "JapaneseEra.h"
 
 using namespace winrt;
 using namespace Windows::Foundation;
 using namespace Windows::Globalization;
 using namespace Windows::Globalization::DateTimeFormatting;
 using namespace Windows::UI::Xaml;
+using namespace winrt::SDKTemplate::CalendarEngine;
 
 namespace winrt::SDKTemplate::implementation
 {
@@ -40,15 +44,24 @@ namespace winrt::SDKTemplate::implementation
         Calendar calendar({ L"en-US" }, CalendarIdentifiers::Japanese(), ClockIdentifiers::TwentyFourHour());
 
         // Enumerate all supported years in all supported Japanese eras.
-        for (calendar.Era(calendar.FirstEra()); true; calendar.AddYears(1))
+        for (calendar.Era(calendar.FirstEra()); true; CALENDAR_ENGINE_MEASURE(CalendarOperation::AddUnits, calendar.AddYears(1)))
         {
             // Process current era.
             results << L"Era " << std::wstring_view(calendar.EraAsString()) <<
                 L" contains " << calendar.NumberOfYearsInThisEra() <<
-                L" year(s)\n";
+                L" year(s)";
+
+            // Windows numbers the eras from Meiji = 1, in the order of JapaneseEras.
+            uint32_t era = static_cast<uint32_t>(calendar.Era() - 1);
+            if (era < JapaneseEraCount)
+            {
+                CivilDate first = CivilFromDays(JapaneseEras[era].firstDay);
+                results << L", beginning " << first.year << L"-" << first.month << L"-" << first.day;
+            }
+            results << L"\n";
 
             // Enumerate all years in this era.
-            for (calendar.Year(calendar.FirstYearInThisEra()); true; calendar.AddYears(1))
+            for (calendar.Year(calendar.FirstYearInThisEra()); true; CALENDAR_ENGINE_MEASURE(CalendarOperation::AddUnits, calendar.AddYears(1)))
             {
                 // Begin sample processing of current year.
 
@@ -107,36 +120,29 @@ namespace winrt::SDKTemplate::implementation
         // An easier way to set the calendar date and time is to set the currentCal.Year, Month, etc. properties.
         // However, we calculate it the complicated way to demonstrate interoperability between Calendar and Windows::Foundation::DateTime.
         // DST ends in the America/Los_Angeles time zone at 4 November 2012 02:00 PDT = 4 November 2012 09:00 UTC.
-        SYSTEMTIME dstSystemTime;
-        dstSystemTime.wYear = 2012;
-        dstSystemTime.wMonth = 11;
-        dstSystemTime.wDay = 4;
-        dstSystemTime.wHour = 9;
-        dstSystemTime.wMinute = 0;
-        dstSystemTime.wSecond = 0;
-        dstSystemTime.wMilliseconds = 0;
-        FILETIME dstFileTime;
-        SystemTimeToFileTime(&dstSystemTime, &dstFileTime);
-        DateTime dstDateTime = clock::from_file_time(dstFileTime);
+        // The instant is a constant, so the compiler works out its ticks.
+        constexpr int64_t dstTicks = TicksFromUnixSeconds(UnixSecondsFromCivil(2012, 11, 4, 2, 0, 0, -7 * 60));
+        static_assert(dstTicks == TicksFromUnixSeconds(UnixSecondsFromCivil(2012, 11, 4, 9, 0, 0)), "02:00 PDT is 09:00 UTC");
+        DateTime dstDateTime{ TimeSpan{ dstTicks } };
         currentCal.SetDateTime(dstDateTime);
 
         // Set the current calendar to one day before DST change. Create a second calendar for comparision and set it to one day after DST change.
-        Calendar endDate = currentCal.Clone();
-        currentCal.AddDays(-1);
-        endDate.AddDays(1);
+        Calendar endDate = CALENDAR_ENGINE_MEASURE(CalendarOperation::Clone, currentCal.Clone());
+        CALENDAR_ENGINE_MEASURE(CalendarOperation::AddUnits, currentCal.AddDays(-1));
+        CALENDAR_ENGINE_MEASURE(CalendarOperation::AddUnits, endDate.AddDays(1));
 
         // Enumerate the day before, the day of, and the day after the 2012 DST-to-Standard time transition
         while (currentCal.Day() <= endDate.Day())
         {
             // Process current day.
             DateTime date = currentCal.GetDateTime();
-            results << std::wstring_view(displayDate.Format(date)) << L" contains " << currentCal.NumberOfHoursInThisPeriod() << L" hour(s)\n";
+            results << std::wstring_view(CALENDAR_ENGINE_MEASURE(CalendarOperation::Format, displayDate.Format(date))) << L" contains " << currentCal.NumberOfHoursInThisPeriod() << L" hour(s)\n";
 
             // Enumerate all hours in this day.
             // Create a calendar to represent the following day.
-            Calendar nextDay = currentCal.Clone();
-            nextDay.AddDays(1);
-            for (currentCal.Hour(currentCal.FirstHourInThisPeriod()); true; currentCal.AddHours(1))
+            Calendar nextDay = CALENDAR_ENGINE_MEASURE(CalendarOperation::Clone, currentCal.Clone());
+            CALENDAR_ENGINE_MEASURE(CalendarOperation::AddUnits, nextDay.AddDays(1));
+            for (currentCal.Hour(currentCal.FirstHourInThisPeriod()); true; CALENDAR_ENGINE_MEASURE(CalendarOperation::AddUnits, currentCal.AddHours(1)))
             {
                 // Display the hour for each hour in the day.             
                 results << std::wstring_view(currentCal.HourAsPaddedString(2)) << L" ";
@@ -12,11 +12,13 @@
 #include "pch.h"
 #include "Scenario5_TimeZone.h"
 #include "Scenario5_TimeZone.g.cpp"
+#include "CalendarMetrics.h"
 
 using namespace winrt;
 using namespace Windows::Foundation;
 using namespace Windows::Globalization;
 using namespace Windows::UI::Xaml;
+using namespace winrt::SDKTemplate::CalendarEngine;
 
 namespace
 {
@@ -67,37 +69,37 @@ namespace winrt::SDKTemplate::implementation
         // Show current time in additional time zones
         for (auto&& timeZone : timeZones)
         {
-            calendar.ChangeTimeZone(timeZone);
+            CALENDAR_ENGINE_MEASURE(CalendarOperation::ChangeTimeZone, calendar.ChangeTimeZone(timeZone));
             ReportCalendarData(results, calendar);
         }
         results << L"\n";
 
         // Change back to local time zone
-        calendar.ChangeTimeZone(localTimeZone);
+        CALENDAR_ENGINE_MEASURE(CalendarOperation::ChangeTimeZone, calendar.ChangeTimeZone(localTimeZone));
 
         // Show a time on 14th day of second month of next year.
         // Note the effect of daylight saving time on the results.
         results << L"Same time on 14th day of second month of next year:\n";
-        calendar.AddYears(1); calendar.Month(2); calendar.Day(14);
+        CALENDAR_ENGINE_MEASURE(CalendarOperation::AddUnits, calendar.AddYears(1)); calendar.Month(2); calendar.Day(14);
         ReportCalendarData(results, calendar);
         for (auto&& timeZone : timeZones)
         {
-            calendar.ChangeTimeZone(timeZone);
+            CALENDAR_ENGINE_MEASURE(CalendarOperation::ChangeTimeZone, calendar.ChangeTimeZone(timeZone));
             ReportCalendarData(results, calendar);
         }
         results << L"\n";
 
         // Change back to local time zone
-        calendar.ChangeTimeZone(localTimeZone);
+        CALENDAR_ENGINE_MEASURE(CalendarOperation::ChangeTimeZone, calendar.ChangeTimeZone(localTimeZone));
 
         // Show a time on 14th day of tenth month of next year.
         // Note the effect of daylight saving time on the results.
         results << L"Same time on 14th day of tenth month of next year:\n";
-        calendar.AddMonths(8);
+        CALENDAR_ENGINE_MEASURE(CalendarOperation::AddUnits, calendar.AddMonths(8));
         ReportCalendarData(results, calendar);
         for (auto&& timeZone : timeZones)
         {
-            calendar.ChangeTimeZone(timeZone);
+            CALENDAR_ENGINE_MEASURE(CalendarOperation::ChangeTimeZone, calendar.ChangeTimeZone(timeZone));
             ReportCalendarData(results, calendar);
         }
         results << L"\n";
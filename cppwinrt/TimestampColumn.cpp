@@ -0,0 +1,318 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "pch.h"
+#include "TimestampColumn.h"
+#include "CalendarSimd.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace winrt;
+using namespace winrt::SDKTemplate::CalendarEngine;
+
+namespace
+{
+    const uint32_t TimestampFileMagic = 0x42435354;     // "TSCB"
+    const uint16_t TimestampFileVersion = 1;
+    const uint32_t DecodeChunk = 256;
+
+    inline int64_t FloorDiv(int64_t value, int64_t divisor)
+    {
+        return (value >= 0) ? value / divisor : (value - divisor + 1) / divisor;
+    }
+
+    template <typename T>
+    void WidenScalar(uint8_t const* source, uint32_t count, int64_t base, int64_t* values)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            T delta;
+            std::memcpy(&delta, source + i * sizeof(T), sizeof(T));
+            values[i] = base + static_cast<int64_t>(delta);
+        }
+    }
+
+#ifdef CALENDAR_ENGINE_SSE2
+    // Adds four unsigned 32-bit deltas to a 64-bit base and stores them.
+    inline void StoreWidened(__m128i deltas, __m128i base, int64_t* values)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(values), _mm_add_epi64(base, _mm_unpacklo_epi32(deltas, zero)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(values + 2), _mm_add_epi64(base, _mm_unpackhi_epi32(deltas, zero)));
+    }
+
+    // Widens as many whole groups of 16 (1-byte), 8 (2-byte) or 4 (4-byte) deltas as possible
+    // and returns the number of rows written.
+    uint32_t WidenSimd(uint8_t const* source, uint8_t width, uint32_t count, int64_t base, int64_t* values)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i base64 = _mm_set1_epi64x(base);
+        uint32_t done = 0;
+        if (width == 1)
+        {
+            for (; done + 16 <= count; done += 16)
+            {
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(source + done));
+                __m128i low = _mm_unpacklo_epi8(bytes, zero);
+                __m128i high = _mm_unpackhi_epi8(bytes, zero);
+                StoreWidened(_mm_unpacklo_epi16(low, zero), base64, values + done);
+                StoreWidened(_mm_unpackhi_epi16(low, zero), base64, values + done + 4);
+                StoreWidened(_mm_unpacklo_epi16(high, zero), base64, values + done + 8);
+                StoreWidened(_mm_unpackhi_epi16(high, zero), base64, values + done + 12);
+            }
+        }
+        else if (width == 2)
+        {
+            for (; done + 8 <= count; done += 8)
+            {
+                __m128i words = _mm_loadu_si128(reinterpret_cast<__m128i const*>(source + done * 2));
+                StoreWidened(_mm_unpacklo_epi16(words, zero), base64, values + done);
+                StoreWidened(_mm_unpackhi_epi16(words, zero), base64, values + done + 4);
+            }
+        }
+        else
+        {
+            for (; done + 4 <= count; done += 4)
+            {
+                StoreWidened(_mm_loadu_si128(reinterpret_cast<__m128i const*>(source + done * 4)), base64, values + done);
+            }
+        }
+        return done;
+    }
+#endif
+}
+
+//----------------------------------------------------------------------
+
+void TimestampColumnWriter::Append(int64_t unixSeconds, uint16_t zoneId, int16_t offsetMinutes)
+{
+    if (!m_pending.empty())
+    {
+        int64_t newMin = std::min(m_pendingMin, unixSeconds);
+        int64_t newMax = std::max(m_pendingMax, unixSeconds);
+        if (zoneId != m_pendingZoneId || offsetMinutes != m_pendingOffset ||
+            m_pending.size() == MaxRowsPerBlock || static_cast<uint64_t>(newMax - newMin) > UINT32_MAX)
+        {
+            FlushBlock();
+        }
+    }
+
+    if (m_pending.empty())
+    {
+        m_pendingZoneId = zoneId;
+        m_pendingOffset = offsetMinutes;
+        m_pendingMin = unixSeconds;
+        m_pendingMax = unixSeconds;
+    }
+    m_pendingMin = std::min(m_pendingMin, unixSeconds);
+    m_pendingMax = std::max(m_pendingMax, unixSeconds);
+    m_pending.push_back(unixSeconds);
+}
+
+void TimestampColumnWriter::FlushBlock()
+{
+    if (m_pending.empty())
+    {
+        return;
+    }
+
+    uint64_t range = static_cast<uint64_t>(m_pendingMax - m_pendingMin);
+    uint8_t width = (range <= UINT8_MAX) ? 1 : (range <= UINT16_MAX) ? 2 : 4;
+
+    TimestampBlockHeader header = {};
+    header.baseSeconds = m_pendingMin;
+    header.dataOffset = m_data.size();      // Relative to the data section until Finish.
+    header.firstDay = static_cast<int32_t>(FloorDiv(m_pendingMin, 86400));
+    header.lastDay = static_cast<int32_t>(FloorDiv(m_pendingMax, 86400));
+    header.rowCount = static_cast<uint32_t>(m_pending.size());
+    header.zoneId = m_pendingZoneId;
+    header.offsetMinutes = m_pendingOffset;
+    header.deltaWidth = width;
+    m_blocks.push_back(header);
+
+    size_t start = m_data.size();
+    size_t padded = (m_pending.size() * width + 15) & ~static_cast<size_t>(15);
+    m_data.resize(start + padded, 0);
+    for (size_t i = 0; i < m_pending.size(); i++)
+    {
+        uint32_t delta = static_cast<uint32_t>(m_pending[i] - m_pendingMin);
+        // Little-endian, so the low bytes are the delta at every width.
+        std::memcpy(&m_data[start + i * width], &delta, width);
+    }
+
+    m_rowCount += m_pending.size();
+    m_pending.clear();
+}
+
+std::vector<uint8_t> TimestampColumnWriter::Finish()
+{
+    FlushBlock();
+
+    TimestampFileHeader header = {};
+    header.magic = TimestampFileMagic;
+    header.version = TimestampFileVersion;
+    header.blockCount = static_cast<uint32_t>(m_blocks.size());
+    header.rowCount = m_rowCount;
+
+    size_t directorySize = sizeof(TimestampBlockHeader) * m_blocks.size();
+    size_t dataStart = (sizeof(header) + directorySize + 15) & ~static_cast<size_t>(15);
+    for (auto&& block : m_blocks)
+    {
+        block.dataOffset += dataStart;
+    }
+
+    std::vector<uint8_t> image(dataStart + m_data.size(), 0);
+    std::memcpy(image.data(), &header, sizeof(header));
+    if (!m_blocks.empty())
+    {
+        std::memcpy(image.data() + sizeof(header), m_blocks.data(), directorySize);
+    }
+    if (!m_data.empty())
+    {
+        std::memcpy(image.data() + dataStart, m_data.data(), m_data.size());
+    }
+
+    m_blocks.clear();
+    m_data.clear();
+    m_rowCount = 0;
+    return image;
+}
+
+//----------------------------------------------------------------------
+
+TimestampColumnReader::TimestampColumnReader(_In_reads_bytes_(size) void const* data, size_t size) :
+    m_data(static_cast<uint8_t const*>(data)),
+    m_header(static_cast<TimestampFileHeader const*>(data)),
+    m_blocks(reinterpret_cast<TimestampBlockHeader const*>(m_data + sizeof(TimestampFileHeader)))
+{
+    if (size < sizeof(TimestampFileHeader) ||
+        m_header->magic != TimestampFileMagic ||
+        m_header->version != TimestampFileVersion ||
+        (size - sizeof(TimestampFileHeader)) / sizeof(TimestampBlockHeader) < m_header->blockCount)
+    {
+        throw hresult_invalid_argument();
+    }
+
+    for (uint32_t i = 0; i < m_header->blockCount; i++)
+    {
+        TimestampBlockHeader const& block = m_blocks[i];
+        if ((block.deltaWidth != 1 && block.deltaWidth != 2 && block.deltaWidth != 4) ||
+            block.dataOffset > size ||
+            (size - block.dataOffset) / block.deltaWidth < block.rowCount)
+        {
+            throw hresult_invalid_argument();
+        }
+    }
+}
+
+std::vector<uint32_t> TimestampColumnReader::BlocksInDayRange(int32_t firstDay, int32_t lastDay) const
+{
+    std::vector<uint32_t> blocks;
+    for (uint32_t i = 0; i < m_header->blockCount; i++)
+    {
+        if (m_blocks[i].lastDay >= firstDay && m_blocks[i].firstDay <= lastDay)
+        {
+            blocks.push_back(i);
+        }
+    }
+    return blocks;
+}
+
+void TimestampColumnReader::DecodeRange(
+    TimestampBlockHeader const& header,
+    uint32_t first,
+    uint32_t count,
+    int64_t bias,
+    _Out_writes_(count) int64_t* values
+    ) const
+{
+    uint8_t const* source = m_data + header.dataOffset + static_cast<size_t>(first) * header.deltaWidth;
+    int64_t base = header.baseSeconds + bias;
+    uint32_t done = 0;
+
+#ifdef CALENDAR_ENGINE_SSE2
+    done = WidenSimd(source, header.deltaWidth, count, base, values);
+    source += static_cast<size_t>(done) * header.deltaWidth;
+#endif
+
+    switch (header.deltaWidth)
+    {
+    case 1: WidenScalar<uint8_t>(source, count - done, base, values + done); break;
+    case 2: WidenScalar<uint16_t>(source, count - done, base, values + done); break;
+    default: WidenScalar<uint32_t>(source, count - done, base, values + done); break;
+    }
+}
+
+void TimestampColumnReader::DecodeInstants(uint32_t block, _Out_writes_(Block(block).rowCount) int64_t* unixSeconds) const
+{
+    TimestampBlockHeader const& header = m_blocks[block];
+    DecodeRange(header, 0, header.rowCount, 0, unixSeconds);
+}
+
+void TimestampColumnReader::DecodeField(uint32_t block, CalendarField field, _Out_writes_(Block(block).rowCount) int32_t* values) const
+{
+    TimestampBlockHeader const& header = m_blocks[block];
+    int64_t bias = static_cast<int64_t>(header.offsetMinutes) * 60;
+
+    // Rows of a block are usually close in time, so the civil date of the previous
+    // row is reused rather than recomputed.
+    int64_t cachedDay = INT64_MIN;
+    CivilDate cachedDate = {};
+
+    int64_t local[DecodeChunk];
+    for (uint32_t first = 0; first < header.rowCount; first += DecodeChunk)
+    {
+        uint32_t count = std::min(DecodeChunk, header.rowCount - first);
+        DecodeRange(header, first, count, bias, local);
+
+        int32_t* out = values + first;
+        switch (field)
+        {
+        case CalendarField::Hour:
+            for (uint32_t i = 0; i < count; i++)
+            {
+                out[i] = static_cast<int32_t>((local[i] - FloorDiv(local[i], 86400) * 86400) / 3600);
+            }
+            break;
+        case CalendarField::Minute:
+            for (uint32_t i = 0; i < count; i++)
+            {
+                out[i] = static_cast<int32_t>((local[i] - FloorDiv(local[i], 3600) * 3600) / 60);
+            }
+            break;
+        case CalendarField::Second:
+            for (uint32_t i = 0; i < count; i++)
+            {
+                out[i] = static_cast<int32_t>(local[i] - FloorDiv(local[i], 60) * 60);
+            }
+            break;
+        case CalendarField::DayOfWeek:
+            for (uint32_t i = 0; i < count; i++)
+            {
+                out[i] = static_cast<int32_t>(WeekdayFromDays(static_cast<int32_t>(FloorDiv(local[i], 86400))));
+            }
+            break;
+        default:
+            for (uint32_t i = 0; i < count; i++)
+            {
+                int64_t day = FloorDiv(local[i], 86400);
+                if (day != cachedDay)
+                {
+                    cachedDay = day;
+                    cachedDate = CivilFromDays(static_cast<int32_t>(day));
+                }
+                out[i] = (field == CalendarField::Year) ? cachedDate.year :
+                    static_cast<int32_t>((field == CalendarField::Month) ? cachedDate.month : cachedDate.day);
+            }
+            break;
+        }
+    }
+}
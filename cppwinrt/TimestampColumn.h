@@ -0,0 +1,128 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+// TimestampColumn:
+// A columnar block format for timestamps, so that calendar-decomposed data (year, month,
+// day, hour, zone) does not have to be stored redundantly on every row.
+//
+//     TimestampFileHeader
+//     TimestampBlockHeader[blockCount]     block directory
+//     block data                           one fixed-width delta per row, 16-byte aligned
+//
+// Each block holds up to MaxRowsPerBlock instants that share one zone and one UTC offset.
+// Rows are stored as unsigned deltas from the smallest instant in the block, 1, 2 or 4
+// bytes wide, which keeps random access and lets the decoder widen 16 rows per SIMD load.
+// The directory records the UTC day range of every block so that a date-sliced scan
+// reads only the blocks it needs.
+//
+// TimestampColumnReader works in place on a buffer (typically a MappedFile view); it
+// never copies row data.  Calendar fields are decoded lazily, one column at a time.
+
+#include <vector>
+#include "CivilDate.h"
+
+namespace winrt::SDKTemplate::CalendarEngine
+{
+    struct TimestampFileHeader
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t reserved;
+        uint32_t blockCount;
+        uint32_t reserved2;
+        uint64_t rowCount;
+    };
+    static_assert(sizeof(TimestampFileHeader) == 24, "TimestampFileHeader is part of the file format");
+
+    struct TimestampBlockHeader
+    {
+        int64_t  baseSeconds;       // Smallest UTC instant in the block.
+        uint64_t dataOffset;        // From the start of the file.
+        int32_t  firstDay;          // UTC day range covered by the block.
+        int32_t  lastDay;
+        uint32_t rowCount;
+        uint16_t zoneId;
+        int16_t  offsetMinutes;     // Local time = UTC + offsetMinutes for every row of the block.
+        uint8_t  deltaWidth;        // 1, 2 or 4 bytes.
+        uint8_t  reserved[7];
+    };
+    static_assert(sizeof(TimestampBlockHeader) == 40, "TimestampBlockHeader is part of the file format");
+
+    enum class CalendarField
+    {
+        Year,
+        Month,
+        Day,
+        DayOfWeek,
+        Hour,
+        Minute,
+        Second,
+    };
+
+    class TimestampColumnWriter
+    {
+    public:
+        static const uint32_t MaxRowsPerBlock = 4096;
+
+        // A new block is started whenever the zone or offset changes.
+        void Append(int64_t unixSeconds, uint16_t zoneId, int16_t offsetMinutes);
+
+        // Returns the complete file image and resets the writer.
+        std::vector<uint8_t> Finish();
+
+    private:
+        void FlushBlock();
+
+        std::vector<int64_t>              m_pending;
+        uint16_t                          m_pendingZoneId = 0;
+        int16_t                           m_pendingOffset = 0;
+        int64_t                           m_pendingMin = 0;
+        int64_t                           m_pendingMax = 0;
+        std::vector<TimestampBlockHeader> m_blocks;
+        std::vector<uint8_t>              m_data;
+        uint64_t                          m_rowCount = 0;
+    };
+
+    class TimestampColumnReader
+    {
+    public:
+        // Validates the header and directory; throws hresult_invalid_argument for a corrupt image.
+        // The buffer must outlive the reader.
+        TimestampColumnReader(_In_reads_bytes_(size) void const* data, size_t size);
+
+        uint64_t RowCount() const { return m_header->rowCount; }
+        uint32_t BlockCount() const { return m_header->blockCount; }
+        TimestampBlockHeader const& Block(uint32_t block) const { return m_blocks[block]; }
+
+        // Blocks whose UTC day range intersects [firstDay, lastDay].
+        std::vector<uint32_t> BlocksInDayRange(int32_t firstDay, int32_t lastDay) const;
+
+        void DecodeInstants(uint32_t block, _Out_writes_(Block(block).rowCount) int64_t* unixSeconds) const;
+
+        // Local calendar field of every row in the block.
+        void DecodeField(uint32_t block, CalendarField field, _Out_writes_(Block(block).rowCount) int32_t* values) const;
+
+    private:
+        void DecodeRange(
+            TimestampBlockHeader const& header,
+            uint32_t first,
+            uint32_t count,
+            int64_t bias,
+            _Out_writes_(count) int64_t* values
+            ) const;
+
+        uint8_t const*              m_data;
+        TimestampFileHeader const*  m_header;
+        TimestampBlockHeader const* m_blocks;
+    };
+}
@@ -0,0 +1,220 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "pch.h"
+#include "TimestampParser.h"
+#include "CalendarSimd.h"
+#include <cstring>
+
+using namespace winrt::SDKTemplate::CalendarEngine;
+
+namespace
+{
+    // Layout of "YYYY-MM-DDTHH:MM", the part every timestamp shares.
+    const uint32_t PrefixDigitBits = 0xDB6F;        // Offsets 0-3, 5-6, 8-9, 11-12, 14-15.
+    const uint32_t PrefixSeparatorBits = 0x2090;    // Offsets 4, 7, 13.
+
+    inline bool IsDigit(char c)
+    {
+        return static_cast<unsigned char>(c - '0') <= 9;
+    }
+
+    inline uint32_t TwoDigits(char const* p)
+    {
+        return static_cast<uint32_t>(p[0] - '0') * 10 + static_cast<uint32_t>(p[1] - '0');
+    }
+
+    bool IsValidPrefix(char const* p)
+    {
+#ifdef CALENDAR_ENGINE_SSE2
+        const __m128i text = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+        const __m128i separators = _mm_setr_epi8(0, 0, 0, 0, '-', 0, 0, '-', 0, 0, 0, 0, 0, ':', 0, 0);
+
+        // Subtracting '0' maps digits to 0..9; anything else saturates above zero after a further -9.
+        __m128i digits = _mm_subs_epu8(_mm_sub_epi8(text, _mm_set1_epi8('0')), _mm_set1_epi8(9));
+        uint32_t digitBits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(digits, _mm_setzero_si128())));
+        uint32_t separatorBits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(text, separators)));
+
+        if (((digitBits & PrefixDigitBits) != PrefixDigitBits) ||
+            ((separatorBits & PrefixSeparatorBits) != PrefixSeparatorBits))
+        {
+            return false;
+        }
+#else
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            if ((PrefixDigitBits & (1u << i)) != 0 && !IsDigit(p[i]))
+            {
+                return false;
+            }
+        }
+        if (p[4] != '-' || p[7] != '-' || p[13] != ':')
+        {
+            return false;
+        }
+#endif
+        return (p[10] == 'T' || p[10] == 't' || p[10] == ' ');
+    }
+
+    template <typename LineHandler>
+    void ForEachLine(std::string_view buffer, LineHandler&& handler)
+    {
+        char const* current = buffer.data();
+        char const* end = current + buffer.size();
+        while (current < end)
+        {
+            // memchr is vectorized by the CRT, so finding line ends is not the bottleneck.
+            char const* newline = static_cast<char const*>(std::memchr(current, '\n', end - current));
+            char const* lineEnd = (newline != nullptr) ? newline : end;
+            std::string_view line(current, lineEnd - current);
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.remove_suffix(1);
+            }
+            handler(line);
+            current = lineEnd + 1;
+        }
+    }
+}
+
+bool winrt::SDKTemplate::CalendarEngine::TryParseTimestamp(std::string_view text, _Out_ Timestamp* result) noexcept
+{
+    *result = InvalidTimestamp;
+
+    // Shortest valid form is "YYYY-MM-DDTHH:MM:SSZ".
+    if (text.size() < 20 || !IsValidPrefix(text.data()))
+    {
+        return false;
+    }
+    char const* p = text.data();
+    char const* end = p + text.size();
+    if (p[16] != ':' || !IsDigit(p[17]) || !IsDigit(p[18]))
+    {
+        return false;
+    }
+
+    int32_t year = static_cast<int32_t>(TwoDigits(p) * 100 + TwoDigits(p + 2));
+    uint32_t month = TwoDigits(p + 5);
+    uint32_t day = TwoDigits(p + 8);
+    uint32_t hour = TwoDigits(p + 11);
+    uint32_t minute = TwoDigits(p + 14);
+    uint32_t second = TwoDigits(p + 17);
+    if (month < 1 || month > 12 || day < 1 || day > DaysInMonth(year, month) ||
+        hour > 23 || minute > 59 || second > 60)
+    {
+        return false;
+    }
+    p += 19;
+
+    uint32_t nanoseconds = 0;
+    if (*p == '.' || *p == ',')
+    {
+        p++;
+        char const* fractionStart = p;
+        uint32_t scale = 100000000;
+        for (; p < end && IsDigit(*p); p++)
+        {
+            nanoseconds += static_cast<uint32_t>(*p - '0') * scale;
+            scale /= 10;
+        }
+        if (p == fractionStart || p == end)
+        {
+            return false;
+        }
+    }
+
+    int32_t offsetMinutes;
+    if ((*p == 'Z' || *p == 'z') && (end - p) == 1)
+    {
+        offsetMinutes = 0;
+    }
+    else if (*p == '+' || *p == '-')
+    {
+        ptrdiff_t length = end - p;
+        uint32_t offsetHour;
+        uint32_t offsetMinute;
+        if (length == 6 && p[3] == ':' && IsDigit(p[1]) && IsDigit(p[2]) && IsDigit(p[4]) && IsDigit(p[5]))
+        {
+            offsetHour = TwoDigits(p + 1);
+            offsetMinute = TwoDigits(p + 4);
+        }
+        else if (length == 5 && IsDigit(p[1]) && IsDigit(p[2]) && IsDigit(p[3]) && IsDigit(p[4]))
+        {
+            offsetHour = TwoDigits(p + 1);
+            offsetMinute = TwoDigits(p + 3);
+        }
+        else
+        {
+            return false;
+        }
+        if (offsetHour > 23 || offsetMinute > 59)
+        {
+            return false;
+        }
+        offsetMinutes = static_cast<int32_t>(offsetHour * 60 + offsetMinute);
+        offsetMinutes = (*p == '-') ? -offsetMinutes : offsetMinutes;
+    }
+    else
+    {
+        return false;
+    }
+
+    result->unixSeconds =
+        static_cast<int64_t>(DaysFromCivil(year, month, day)) * 86400 +
+        static_cast<int64_t>(hour * 3600 + minute * 60 + second) -
+        static_cast<int64_t>(offsetMinutes) * 60;
+    result->nanoseconds = nanoseconds;
+    result->offsetMinutes = static_cast<int16_t>(offsetMinutes);
+    return true;
+}
+
+size_t winrt::SDKTemplate::CalendarEngine::ParseTimestampLines(std::string_view buffer, std::vector<Timestamp>& results)
+{
+    size_t failures = 0;
+    ForEachLine(buffer, [&](std::string_view line)
+    {
+        Timestamp timestamp;
+        failures += TryParseTimestamp(line, &timestamp) ? 0 : 1;
+        results.push_back(timestamp);
+    });
+    return failures;
+}
+
+size_t winrt::SDKTemplate::CalendarEngine::ParseTimestampColumn(
+    std::string_view buffer,
+    char separator,
+    uint32_t column,
+    std::vector<Timestamp>& results
+    )
+{
+    size_t failures = 0;
+    ForEachLine(buffer, [&](std::string_view line)
+    {
+        // Skip to the requested field.
+        size_t start = 0;
+        for (uint32_t field = 0; field < column && start != std::string_view::npos; field++)
+        {
+            start = line.find(separator, start);
+            start = (start != std::string_view::npos) ? start + 1 : start;
+        }
+
+        Timestamp timestamp = InvalidTimestamp;
+        if (start != std::string_view::npos)
+        {
+            size_t fieldEnd = line.find(separator, start);
+            std::string_view field = line.substr(start, (fieldEnd == std::string_view::npos) ? std::string_view::npos : fieldEnd - start);
+            TryParseTimestamp(field, &timestamp);
+        }
+        failures += (timestamp.unixSeconds == InvalidTimestamp.unixSeconds) ? 1 : 0;
+        results.push_back(timestamp);
+    });
+    return failures;
+}
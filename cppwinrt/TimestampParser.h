@@ -0,0 +1,64 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+// TimestampParser:
+// Parses ISO-8601 / RFC-3339 date-time strings straight into UTC instants, without going
+// through SYSTEMTIME or a Calendar object.  Accepted form:
+//
+//     YYYY-MM-DD('T' | 't' | ' ')HH:MM:SS[('.' | ',')fraction]('Z' | 'z' | +HH:MM | -HH:MM | +HHMM | -HHMM)
+//
+// The fixed 16-byte prefix is validated with one SIMD compare where available.  Fractions
+// longer than nine digits are truncated to nanoseconds.  A leap second (SS = 60) is
+// accepted and lands on the first instant of the following minute.
+//
+// The batch functions parse one field out of every line of a text buffer, as found in
+// log files and CSV exports.  They never throw for malformed input; failed rows are
+// written as InvalidTimestamp and counted.
+
+#include <string_view>
+#include <vector>
+#include "CivilDate.h"
+
+namespace winrt::SDKTemplate::CalendarEngine
+{
+    struct Timestamp
+    {
+        int64_t  unixSeconds;       // UTC seconds since 1970-01-01T00:00:00Z.
+        uint32_t nanoseconds;       // 0..999999999
+        int16_t  offsetMinutes;     // UTC offset written in the source text.
+
+        int32_t Day() const
+        {
+            return static_cast<int32_t>(unixSeconds >= 0 ? unixSeconds / 86400 : (unixSeconds - 86399) / 86400);
+        }
+    };
+
+    static const Timestamp InvalidTimestamp = { INT64_MIN, 0, 0 };
+
+    // Returns false if 'text' is not exactly one timestamp.
+    bool TryParseTimestamp(std::string_view text, _Out_ Timestamp* result) noexcept;
+
+    // Parses one timestamp per line of 'buffer'.  Lines end with '\n' (an optional
+    // preceding '\r' is ignored); a trailing line without a terminator is included.
+    // Returns the number of lines that failed to parse.
+    size_t ParseTimestampLines(std::string_view buffer, std::vector<Timestamp>& results);
+
+    // Parses field 'column' (zero based) of every line, where fields are separated by
+    // 'separator'.  Lines with fewer fields count as failures.
+    size_t ParseTimestampColumn(
+        std::string_view buffer,
+        char separator,
+        uint32_t column,
+        std::vector<Timestamp>& results
+        );
+}
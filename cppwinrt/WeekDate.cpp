@@ -0,0 +1,180 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "pch.h"
+#include "WeekDate.h"
+#include "CalendarSimd.h"
+#include <algorithm>
+
+using namespace winrt;
+using namespace winrt::SDKTemplate::CalendarEngine;
+
+namespace
+{
+    const uint32_t SecondsChunk = 256;
+
+    inline int64_t FloorDiv(int64_t value, int64_t divisor)
+    {
+        int64_t quotient = value / divisor;
+        return (value % divisor < 0) ? quotient - 1 : quotient;
+    }
+
+    void CheckRule(WeekRule const& rule)
+    {
+        if (rule.firstDayOfWeek > 6 || rule.minimalDays < 1 || rule.minimalDays > 7)
+        {
+            throw hresult_invalid_argument();
+        }
+    }
+
+    // Days from the start of the week back to 'days'.
+    inline int32_t DayInWeek(int32_t days, WeekRule const& rule)
+    {
+        return static_cast<int32_t>((WeekdayFromDays(days) + 7 - rule.firstDayOfWeek) % 7);
+    }
+
+    int32_t WeekStart(int32_t weekYear, WeekRule const& rule)
+    {
+        // The week holding 1 January is week 1 if at least minimalDays of it fall in January.
+        int32_t january1 = DaysFromCivil(weekYear, 1, 1);
+        int32_t start = january1 - DayInWeek(january1, rule);
+        return (january1 - start <= static_cast<int32_t>(7 - rule.minimalDays)) ? start : start + 7;
+    }
+
+    // The week-year found last: week 1 starts on 'start' and has key 'first'.  Its days,
+    // cut to the supported range, are [low, high).
+    struct WeekYearRange
+    {
+        int32_t low;
+        int32_t high;
+        int32_t start;
+        int32_t first;
+    };
+
+    int32_t ScalarKey(int32_t day, WeekRule const& rule, WeekYearRange& range, size_t& failures)
+    {
+        if (day < range.low || day >= range.high)
+        {
+            if (day < FirstWeekDay || day > LastWeekDay)
+            {
+                failures++;
+                return InvalidDay;
+            }
+            int32_t weekYear = CivilFromDays(day - DayInWeek(day, rule) + 7 - static_cast<int32_t>(rule.minimalDays)).year;
+            int32_t start = WeekStart(weekYear, rule);
+            range = { std::max(start, FirstWeekDay), std::min(WeekStart(weekYear + 1, rule), LastWeekDay + 1), start, weekYear * 100 + 1 };
+        }
+        return range.first + (day - range.start) / 7;
+    }
+}
+
+int32_t winrt::SDKTemplate::CalendarEngine::FirstWeekStart(int32_t weekYear, WeekRule const& rule)
+{
+    CheckRule(rule);
+    return WeekStart(weekYear, rule);
+}
+
+uint32_t winrt::SDKTemplate::CalendarEngine::WeeksInYear(int32_t weekYear, WeekRule const& rule)
+{
+    CheckRule(rule);
+    return static_cast<uint32_t>(WeekStart(weekYear + 1, rule) - WeekStart(weekYear, rule)) / 7;
+}
+
+WeekDate winrt::SDKTemplate::CalendarEngine::WeekDateFromDays(int32_t days, WeekRule const& rule)
+{
+    CheckRule(rule);
+    if (days < FirstWeekDay || days > LastWeekDay)
+    {
+        throw hresult_out_of_bounds();
+    }
+
+    int32_t weekStart = days - DayInWeek(days, rule);
+    CivilDate anchor = CivilFromDays(weekStart + 7 - static_cast<int32_t>(rule.minimalDays));
+    int32_t dayOfYear = weekStart + 7 - static_cast<int32_t>(rule.minimalDays) - DaysFromCivil(anchor.year, 1, 1);
+    return { anchor.year, static_cast<uint32_t>(dayOfYear / 7 + 1), WeekdayFromDays(days) };
+}
+
+int32_t winrt::SDKTemplate::CalendarEngine::DaysFromWeekDate(WeekDate const& date, WeekRule const& rule)
+{
+    if (date.week < 1 || date.week > WeeksInYear(date.weekYear, rule) || date.dayOfWeek > 6)
+    {
+        throw hresult_invalid_argument();
+    }
+    return WeekStart(date.weekYear, rule) + static_cast<int32_t>((date.week - 1) * 7 + (date.dayOfWeek + 7 - rule.firstDayOfWeek) % 7);
+}
+
+size_t winrt::SDKTemplate::CalendarEngine::WeekKeys(
+    _In_reads_(count) int32_t const* days,
+    WeekRule const& rule,
+    _Out_writes_(count) int32_t* keys,
+    size_t count
+    )
+{
+    CheckRule(rule);
+    WeekYearRange range = { 0, 0, 0, 0 };
+    size_t failures = 0;
+    size_t i = 0;
+
+#ifdef CALENDAR_ENGINE_SSE2
+    // The offset into the week-year is below 2^16, so the division by 7 is a 16-bit
+    // multiply-high by ceil(2^16 / 7); it is exact up to several thousand.
+    const __m128i divideBy7 = _mm_set1_epi32(9363);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i value = _mm_loadu_si128(reinterpret_cast<__m128i const*>(days + i));
+        __m128i below = _mm_cmplt_epi32(value, _mm_set1_epi32(range.low));
+        __m128i inside = _mm_andnot_si128(below, _mm_cmplt_epi32(value, _mm_set1_epi32(range.high)));
+        if (_mm_movemask_epi8(inside) == 0xFFFF)
+        {
+            __m128i week = _mm_mulhi_epu16(_mm_sub_epi32(value, _mm_set1_epi32(range.start)), divideBy7);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(keys + i), _mm_add_epi32(week, _mm_set1_epi32(range.first)));
+            continue;
+        }
+        for (size_t j = i; j < i + 4; j++)
+        {
+            keys[j] = ScalarKey(days[j], rule, range, failures);
+        }
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        keys[i] = ScalarKey(days[i], rule, range, failures);
+    }
+    return failures;
+}
+
+size_t winrt::SDKTemplate::CalendarEngine::WeekKeys(
+    _In_reads_(count) int64_t const* unixSeconds,
+    int32_t offsetSeconds,
+    WeekRule const& rule,
+    _Out_writes_(count) int32_t* keys,
+    size_t count
+    )
+{
+    CheckRule(rule);
+    int32_t days[SecondsChunk];
+    size_t failures = 0;
+    for (size_t first = 0; first < count; first += SecondsChunk)
+    {
+        size_t chunk = std::min<size_t>(count - first, SecondsChunk);
+        for (size_t i = 0; i < chunk; i++)
+        {
+            // Apply the offset to the time of day so that it cannot overflow the seconds.
+            int64_t day = unixSeconds[first + i] / 86400;
+            int64_t timeOfDay = unixSeconds[first + i] % 86400;
+            day += FloorDiv(timeOfDay + offsetSeconds, 86400);
+            days[i] = (day >= FirstWeekDay && day <= LastWeekDay) ? static_cast<int32_t>(day) : InvalidDay;
+        }
+        failures += WeekKeys(days, rule, keys + first, chunk);
+    }
+    return failures;
+}
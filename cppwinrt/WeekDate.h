@@ -0,0 +1,85 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+// WeekDate:
+// Week-of-year numbering in closed form.  A rule names the first day of the week and the
+// minimal number of days of a year that its first week must contain: ISO 8601 weeks
+// start on Monday and week 1 is the one holding at least four days of January, that is
+// the week with the year's first Thursday.  Other locales use Sunday or Saturday and one
+// day.  The rule is the same one ICU and java.time use, so their week numbers agree.
+//
+// A week belongs to the week-year that holds at least minimalDays of its days, which is
+// the civil year of its (8 - minimalDays)-th day.  Every date in [0001-01-01, 9999-12-31]
+// is supported; around the ends of that range the week-year may be 0 or 10000.
+//
+// The batch forms turn a column of days (or UTC instants plus a fixed offset) into
+// sortable keys weekYear * 100 + week, e.g. 202501, for GROUP BY week.  Every week-year
+// spans a contiguous range of day numbers, so they keep the range of the week-year found
+// last and key four rows at a time while the rows stay inside it.
+
+#include "CivilDate.h"
+
+namespace winrt::SDKTemplate::CalendarEngine
+{
+    struct WeekRule
+    {
+        uint32_t firstDayOfWeek;    // DayOfWeek, Sunday = 0.
+        uint32_t minimalDays;       // 1..7
+    };
+
+    namespace WeekRules
+    {
+        static const WeekRule Iso         = { 1, 4 };
+        static const WeekRule Sunday      = { 0, 1 };   // United States, Canada, Japan.
+        static const WeekRule Saturday    = { 6, 1 };   // Much of the Middle East.
+    }
+
+    struct WeekDate
+    {
+        int32_t  weekYear;
+        uint32_t week;          // 1..53
+        uint32_t dayOfWeek;     // DayOfWeek, Sunday = 0.
+    };
+
+    constexpr int32_t FirstWeekDay = DaysFromCivil(1, 1, 1);
+    constexpr int32_t LastWeekDay = DaysFromCivil(9999, 12, 31);
+
+    // All of these throw hresult_invalid_argument for a rule outside the ranges above.
+    // Day of week 1 of a week-year.
+    int32_t FirstWeekStart(int32_t weekYear, WeekRule const& rule);
+    uint32_t WeeksInYear(int32_t weekYear, WeekRule const& rule);
+
+    // Throws hresult_out_of_bounds outside [FirstWeekDay, LastWeekDay].
+    WeekDate WeekDateFromDays(int32_t days, WeekRule const& rule);
+
+    // Throws hresult_invalid_argument for a week the year does not have.
+    int32_t DaysFromWeekDate(WeekDate const& date, WeekRule const& rule);
+
+    // Batch forms.  Rows outside [FirstWeekDay, LastWeekDay] are written as InvalidDay and
+    // counted; an invalid rule still throws, before any row is written.
+    size_t WeekKeys(
+        _In_reads_(count) int32_t const* days,
+        WeekRule const& rule,
+        _Out_writes_(count) int32_t* keys,
+        size_t count
+        );
+
+    // Local days are taken at UTC + offsetSeconds.
+    size_t WeekKeys(
+        _In_reads_(count) int64_t const* unixSeconds,
+        int32_t offsetSeconds,
+        WeekRule const& rule,
+        _Out_writes_(count) int32_t* keys,
+        size_t count
+        );
+}
@@ -0,0 +1,346 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "pch.h"
+#include "ZoneDatabase.h"
+#include "CalendarMetrics.h"
+#include <algorithm>
+
+using namespace winrt;
+using namespace winrt::SDKTemplate::CalendarEngine;
+
+namespace
+{
+    inline int64_t FloorDiv(int64_t value, int64_t divisor)
+    {
+        return (value >= 0) ? value / divisor : (value - divisor + 1) / divisor;
+    }
+
+    // True if [offset, offset + count * size) lies inside an image of imageSize bytes.
+    inline bool SectionFits(size_t imageSize, uint32_t offset, uint32_t count, size_t size)
+    {
+        return offset <= imageSize && (imageSize - offset) / size >= count;
+    }
+
+    bool IsValidRule(TransitionRule const& rule)
+    {
+        switch (rule.kind)
+        {
+        case TransitionRuleKind::JulianNoLeap:
+            return rule.day >= 1 && rule.day <= 365;
+        case TransitionRuleKind::JulianZeroBased:
+            return rule.day <= 365;
+        case TransitionRuleKind::MonthWeekDay:
+            return rule.month >= 1 && rule.month <= 12 && rule.week >= 1 && rule.week <= 5 && rule.weekday <= 6;
+        default:
+            return false;
+        }
+    }
+}
+
+int64_t winrt::SDKTemplate::CalendarEngine::TransitionInstant(TransitionRule const& rule, int32_t year, int32_t offsetBefore)
+{
+    int32_t day;
+    switch (rule.kind)
+    {
+    case TransitionRuleKind::JulianNoLeap:
+        day = DaysFromCivil(year, 1, 1) + rule.day - 1;
+        if (IsLeapYear(year) && rule.day >= 60)
+        {
+            day++;
+        }
+        break;
+    case TransitionRuleKind::JulianZeroBased:
+        day = DaysFromCivil(year, 1, 1) + rule.day;
+        break;
+    default:
+    {
+        int32_t first = DaysFromCivil(year, rule.month, 1);
+        int32_t firstMatch = first + static_cast<int32_t>((rule.weekday + 7 - WeekdayFromDays(first)) % 7);
+        day = firstMatch + (rule.week - 1) * 7;
+        int32_t monthEnd = first + static_cast<int32_t>(DaysInMonth(year, rule.month));
+        while (day >= monthEnd)
+        {
+            day -= 7;
+        }
+        break;
+    }
+    }
+    return static_cast<int64_t>(day) * 86400 + rule.time - offsetBefore;
+}
+
+uint16_t winrt::SDKTemplate::CalendarEngine::EvaluateZoneRule(ZoneRule const& rule, _In_ LocalTimeType const* types, int64_t unixSeconds)
+{
+    if (rule.daylightType == NoLocalTimeType)
+    {
+        return rule.standardType;
+    }
+
+    int32_t standardOffset = types[rule.standardType].utcOffset;
+    int32_t daylightOffset = types[rule.daylightType].utcOffset;
+    int32_t year = CivilFromDays(static_cast<int32_t>(FloorDiv(unixSeconds + standardOffset, 86400))).year;
+
+    int64_t start = TransitionInstant(rule.start, year, standardOffset);
+    int64_t end = TransitionInstant(rule.end, year, daylightOffset);
+    bool isDst = (start < end) ?
+        (unixSeconds >= start && unixSeconds < end) :      // Northern hemisphere.
+        (unixSeconds < end || unixSeconds >= start);        // Daylight time spans the new year.
+    return isDst ? rule.daylightType : rule.standardType;
+}
+
+int64_t winrt::SDKTemplate::CalendarEngine::NextZoneRuleTransition(ZoneRule const& rule, _In_ LocalTimeType const* types, int64_t unixSeconds)
+{
+    if (rule.daylightType == NoLocalTimeType)
+    {
+        return INT64_MAX;
+    }
+
+    int32_t standardOffset = types[rule.standardType].utcOffset;
+    int32_t daylightOffset = types[rule.daylightType].utcOffset;
+    int32_t year = CivilFromDays(static_cast<int32_t>(FloorDiv(unixSeconds + standardOffset, 86400))).year;
+
+    // Both transitions of the next year are always later than the instant.
+    int64_t next = INT64_MAX;
+    for (int32_t candidate = year - 1; candidate <= year + 1; candidate++)
+    {
+        for (int64_t instant : { TransitionInstant(rule.start, candidate, standardOffset), TransitionInstant(rule.end, candidate, daylightOffset) })
+        {
+            if (instant > unixSeconds && instant < next)
+            {
+                next = instant;
+            }
+        }
+    }
+    return next;
+}
+
+ZoneDatabase::ZoneDatabase(std::vector<uint8_t> image) :
+    m_image(std::move(image))
+{
+    size_t size = m_image.size();
+    uint8_t const* base = m_image.data();
+    m_header = reinterpret_cast<ZoneDatabaseHeader const*>(base);
+    if (size < sizeof(ZoneDatabaseHeader) ||
+        m_header->magic != Magic ||
+        m_header->version != Version ||
+        !SectionFits(size, m_header->zonesOffset, m_header->zoneCount, sizeof(ZoneRecord)) ||
+        !SectionFits(size, m_header->typesOffset, m_header->typeCount, sizeof(LocalTimeType)) ||
+        !SectionFits(size, m_header->rulesOffset, m_header->ruleCount, sizeof(ZoneRule)) ||
+        !SectionFits(size, m_header->runsOffset, m_header->runCount, sizeof(TransitionRun)) ||
+        !SectionFits(size, m_header->transitionTimesOffset, m_header->transitionCount, sizeof(uint32_t)) ||
+        !SectionFits(size, m_header->transitionTypesOffset, m_header->transitionCount, sizeof(uint8_t)) ||
+        !SectionFits(size, m_header->paletteOffset, m_header->paletteCount, sizeof(uint16_t)) ||
+        !SectionFits(size, m_header->stringsOffset, m_header->stringBytes, 1) ||
+        (m_header->transitionTimesOffset % alignof(uint32_t)) != 0 ||
+        (m_header->paletteOffset % alignof(uint16_t)) != 0 ||
+        m_header->typeCount >= NoLocalTimeType ||
+        m_header->ruleCount >= NoZoneRule ||
+        m_header->runCount == 0 ||
+        m_header->runCount > UINT16_MAX + 1u)
+    {
+        throw hresult_invalid_argument();
+    }
+
+    m_zones = reinterpret_cast<ZoneRecord const*>(base + m_header->zonesOffset);
+    m_types = reinterpret_cast<LocalTimeType const*>(base + m_header->typesOffset);
+    m_rules = reinterpret_cast<ZoneRule const*>(base + m_header->rulesOffset);
+    m_runs = reinterpret_cast<TransitionRun const*>(base + m_header->runsOffset);
+    m_transitionTimes = reinterpret_cast<uint32_t const*>(base + m_header->transitionTimesOffset);
+    m_transitionTypes = base + m_header->transitionTypesOffset;
+    m_palette = reinterpret_cast<uint16_t const*>(base + m_header->paletteOffset);
+    m_strings = reinterpret_cast<char const*>(base + m_header->stringsOffset);
+
+    auto stringFits = [&](uint32_t offset, uint32_t length)
+    {
+        return offset <= m_header->stringBytes && m_header->stringBytes - offset >= length;
+    };
+
+    for (uint32_t i = 0; i < m_header->typeCount; i++)
+    {
+        if (!stringFits(m_types[i].abbreviationOffset, m_types[i].abbreviationLength))
+        {
+            throw hresult_invalid_argument();
+        }
+    }
+    for (uint32_t i = 0; i < m_header->ruleCount; i++)
+    {
+        ZoneRule const& rule = m_rules[i];
+        bool hasDst = rule.daylightType != NoLocalTimeType;
+        if (rule.standardType >= m_header->typeCount ||
+            (hasDst && (rule.daylightType >= m_header->typeCount || !IsValidRule(rule.start) || !IsValidRule(rule.end))))
+        {
+            throw hresult_invalid_argument();
+        }
+    }
+    for (uint32_t i = 0; i < m_header->paletteCount; i++)
+    {
+        if (m_palette[i] >= m_header->typeCount)
+        {
+            throw hresult_invalid_argument();
+        }
+    }
+    for (uint32_t i = 0; i < m_header->runCount; i++)
+    {
+        TransitionRun const& run = m_runs[i];
+        if (run.first > m_header->transitionCount ||
+            m_header->transitionCount - run.first < run.count ||
+            (i == 0 && run.count != 0))
+        {
+            throw hresult_invalid_argument();
+        }
+        for (uint32_t j = run.first; j < run.first + run.count; j++)
+        {
+            if (run.palette + m_transitionTypes[j] >= m_header->paletteCount)
+            {
+                throw hresult_invalid_argument();
+            }
+        }
+    }
+    for (uint32_t i = 0; i < m_header->zoneCount; i++)
+    {
+        ZoneRecord const& zone = m_zones[i];
+        if (!stringFits(zone.nameOffset, zone.nameLength) ||
+            zone.initialType >= m_header->typeCount ||
+            (zone.rule != NoZoneRule && zone.rule >= m_header->ruleCount) ||
+            zone.headRun >= m_header->runCount ||
+            zone.tailRun >= m_header->runCount ||
+            (i > 0 && !(ZoneName(i - 1) < ZoneName(i))))
+        {
+            throw hresult_invalid_argument();
+        }
+        TransitionRun const& head = m_runs[zone.headRun];
+        TransitionRun const& tail = m_runs[zone.tailRun];
+        if (head.count != 0 && tail.count != 0 &&
+            HeadEra + m_transitionTimes[head.first + head.count - 1] >= m_transitionTimes[tail.first])
+        {
+            throw hresult_invalid_argument();
+        }
+    }
+}
+
+std::string_view ZoneDatabase::String(uint32_t offset, uint32_t length) const
+{
+    return std::string_view(m_strings + offset, length);
+}
+
+std::string_view ZoneDatabase::TzdataVersion() const
+{
+    auto const& version = m_header->tzdataVersion;
+    return std::string_view(version, std::find(version, version + sizeof(version), '\0') - version);
+}
+
+std::string_view ZoneDatabase::ZoneName(uint32_t zone) const
+{
+    return String(m_zones[zone].nameOffset, m_zones[zone].nameLength);
+}
+
+std::optional<uint32_t> ZoneDatabase::FindZone(std::string_view name) const
+{
+    uint32_t low = 0;
+    uint32_t high = m_header->zoneCount;
+    while (low < high)
+    {
+        uint32_t middle = low + (high - low) / 2;
+        std::string_view candidate = ZoneName(middle);
+        if (candidate == name)
+        {
+            return middle;
+        }
+        if (candidate < name)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return std::nullopt;
+}
+
+uint16_t ZoneDatabase::TypeAt(ZoneRecord const& zone, int64_t unixSeconds) const
+{
+    // Pick the run that holds the instant; the tail run always follows the head run.
+    TransitionRun const& head = m_runs[zone.headRun];
+    TransitionRun const& tail = m_runs[zone.tailRun];
+    TransitionRun const* run = &head;
+    int64_t era = HeadEra;
+    if (tail.count != 0 && (head.count == 0 || unixSeconds >= m_transitionTimes[tail.first]))
+    {
+        run = &tail;
+        era = 0;
+    }
+    bool lastRun = (run == &tail || tail.count == 0);
+
+    uint32_t const* begin = m_transitionTimes + run->first;
+    uint32_t const* end = begin + run->count;
+    if (begin == end || unixSeconds < era + *begin)
+    {
+        if (head.count == 0 && tail.count == 0 && zone.rule != NoZoneRule)
+        {
+            return EvaluateZoneRule(m_rules[zone.rule], m_types, unixSeconds);
+        }
+        return zone.initialType;
+    }
+
+    // Instants past the end of the era compare greater than every stored transition.
+    uint32_t key = static_cast<uint32_t>(std::min(unixSeconds, era + UINT32_MAX) - era);
+    uint32_t index = static_cast<uint32_t>(std::upper_bound(begin, end, key) - begin) - 1;
+    if (lastRun && index + 1 == run->count && zone.rule != NoZoneRule)
+    {
+        return EvaluateZoneRule(m_rules[zone.rule], m_types, unixSeconds);
+    }
+    return m_palette[run->palette + m_transitionTypes[run->first + index]];
+}
+
+LocalTimeInfo ZoneDatabase::Lookup(uint32_t zone, int64_t unixSeconds) const
+{
+    CALENDAR_ENGINE_TIME_SCOPE(CalendarOperation::ZoneLookup);
+    if (zone >= m_header->zoneCount)
+    {
+        throw hresult_out_of_bounds();
+    }
+    uint16_t type = TypeAt(m_zones[zone], unixSeconds);
+    LocalTimeType const& info = m_types[type];
+    return { info.utcOffset, info.isDst != 0, type, String(info.abbreviationOffset, info.abbreviationLength) };
+}
+
+int64_t ZoneDatabase::NextTransition(uint32_t zone, int64_t unixSeconds) const
+{
+    if (zone >= m_header->zoneCount)
+    {
+        throw hresult_out_of_bounds();
+    }
+    ZoneRecord const& record = m_zones[zone];
+
+    auto nextInRun = [&](TransitionRun const& run, int64_t era) -> int64_t
+    {
+        uint32_t const* begin = m_transitionTimes + run.first;
+        uint32_t const* end = begin + run.count;
+        if (begin == end || unixSeconds >= era + end[-1])
+        {
+            return INT64_MAX;
+        }
+        if (unixSeconds < era)
+        {
+            return era + *begin;
+        }
+        return era + *std::upper_bound(begin, end, static_cast<uint32_t>(unixSeconds - era));
+    };
+
+    int64_t next = std::min(nextInRun(m_runs[record.headRun], HeadEra), nextInRun(m_runs[record.tailRun], 0));
+    if (next == INT64_MAX && record.rule != NoZoneRule)
+    {
+        // Past the last transition the rule is in charge.
+        next = NextZoneRuleTransition(m_rules[record.rule], m_types, unixSeconds);
+    }
+    return next;
+}
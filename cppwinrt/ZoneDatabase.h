@@ -0,0 +1,193 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+// ZoneDatabase:
+// The native engine's compiled time zone database.  ZoneDatabaseBuilder compiles a set
+// of TZif files (the binary form of the IANA tz database) into a single image with the
+// layout below; ZoneDatabase validates such an image once and then answers
+// "what is the UTC offset of zone Z at instant T" with a binary search over that zone's
+// transitions, or by evaluating the zone's POSIX TZ rule past its last transition.
+//
+// Most zones share their recent history with others (and aliases share all of it), so
+// the builder keeps each zone's transitions as two runs, before and after 1970, and
+// stores each distinct run once.  Local time types, POSIX rules and strings are pooled
+// the same way, and transitions that the POSIX rule already reproduces are dropped.
+//
+// Transition instants are stored as 32-bit seconds from the start of their run's era
+// (HeadEra for runs before 1970, the Unix epoch after), and the type that starts at
+// each transition as an 8-bit index into the run's palette of pooled types.  The head
+// era starts in 1833; older transitions are folded into the zone's initial type.
+//
+//     ZoneDatabaseHeader
+//     ZoneRecord[zoneCount]            sorted by name; aliases are separate records
+//     LocalTimeType[typeCount]
+//     ZoneRule[ruleCount]              compiled POSIX TZ footers
+//     TransitionRun[runCount]          run 0 is the empty run
+//     uint32_t[transitionCount]        transition instants, seconds into the run's era
+//     uint8_t[transitionCount]         palette index of the type starting at each transition
+//     uint16_t[paletteCount]           run palettes, indices into LocalTimeType
+//     char[stringBytes]                zone names and abbreviations
+//
+// A ZoneDatabase is immutable.  See ZoneDatabaseHost for replacing it while readers run.
+
+#include <optional>
+#include <string_view>
+#include <vector>
+#include "CivilDate.h"
+
+namespace winrt::SDKTemplate::CalendarEngine
+{
+    static const uint16_t NoZoneRule = 0xFFFF;
+    static const uint16_t NoLocalTimeType = 0xFFFF;
+
+    struct ZoneDatabaseHeader
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t reserved;
+        char     tzdataVersion[8];      // e.g. "2024a", NUL padded.
+        uint32_t zoneCount;
+        uint32_t typeCount;
+        uint32_t ruleCount;
+        uint32_t runCount;
+        uint32_t transitionCount;
+        uint32_t paletteCount;
+        uint32_t stringBytes;
+        uint32_t zonesOffset;
+        uint32_t typesOffset;
+        uint32_t rulesOffset;
+        uint32_t runsOffset;
+        uint32_t transitionTimesOffset;
+        uint32_t transitionTypesOffset;
+        uint32_t paletteOffset;
+        uint32_t stringsOffset;
+        uint32_t reserved2;
+    };
+    static_assert(sizeof(ZoneDatabaseHeader) == 80, "ZoneDatabaseHeader is part of the file format");
+
+    struct ZoneRecord
+    {
+        uint32_t nameOffset;
+        uint16_t nameLength;
+        uint16_t initialType;           // In effect before the first transition.
+        uint16_t headRun;               // Transitions before 1970.
+        uint16_t tailRun;               // Transitions from 1970 on.
+        uint16_t rule;                  // In effect after the last transition, or NoZoneRule.
+        uint16_t reserved;
+    };
+    static_assert(sizeof(ZoneRecord) == 16, "ZoneRecord is part of the file format");
+
+    struct TransitionRun
+    {
+        uint32_t first;                 // Index of the first transition.
+        uint16_t count;
+        uint16_t palette;               // Index of the first palette entry.
+    };
+    static_assert(sizeof(TransitionRun) == 8, "TransitionRun is part of the file format");
+
+    struct LocalTimeType
+    {
+        int32_t  utcOffset;             // Seconds east of UTC.
+        uint32_t abbreviationOffset;
+        uint8_t  isDst;
+        uint8_t  abbreviationLength;
+        uint16_t reserved;
+    };
+    static_assert(sizeof(LocalTimeType) == 12, "LocalTimeType is part of the file format");
+
+    enum class TransitionRuleKind : uint8_t
+    {
+        None,
+        JulianNoLeap,       // Jn: day 1..365, February 29 is never counted.
+        JulianZeroBased,    // n: day 0..365, counting February 29.
+        MonthWeekDay,       // Mm.w.d: weekday d of week w (5 = last) of month m.
+    };
+
+    struct TransitionRule
+    {
+        TransitionRuleKind kind;
+        uint8_t  month;
+        uint8_t  week;
+        uint8_t  weekday;
+        uint16_t day;
+        uint16_t reserved;
+        int32_t  time;                  // Local seconds after midnight; may be negative or exceed a day.
+    };
+    static_assert(sizeof(TransitionRule) == 12, "TransitionRule is part of the file format");
+
+    struct ZoneRule
+    {
+        uint16_t       standardType;
+        uint16_t       daylightType;    // NoLocalTimeType when the rule has no daylight saving time.
+        TransitionRule start;           // Standard to daylight time.
+        TransitionRule end;             // Daylight to standard time.
+    };
+    static_assert(sizeof(ZoneRule) == 28, "ZoneRule is part of the file format");
+
+    struct LocalTimeInfo
+    {
+        int32_t          utcOffset;
+        bool             isDst;
+        uint16_t         type;
+        std::string_view abbreviation;
+    };
+
+    class ZoneDatabase
+    {
+    public:
+        static const uint32_t Magic = 0x42445A54;       // "TZDB"
+        static const uint16_t Version = 2;
+        static const int64_t  HeadEra = -0x100000000;    // 1833-11-24T17:31:44Z
+
+        // Validates the whole image; throws hresult_invalid_argument if it is malformed.
+        explicit ZoneDatabase(std::vector<uint8_t> image);
+
+        std::string_view TzdataVersion() const;
+        uint32_t ZoneCount() const { return m_header->zoneCount; }
+        std::string_view ZoneName(uint32_t zone) const;
+        std::optional<uint32_t> FindZone(std::string_view name) const;
+
+        LocalTimeInfo Lookup(uint32_t zone, int64_t unixSeconds) const;
+
+        // First instant after 'unixSeconds' at which the zone's local time type may change, or
+        // INT64_MAX if it never changes again.  Lookup is constant between such instants.
+        int64_t NextTransition(uint32_t zone, int64_t unixSeconds) const;
+
+        size_t ImageSize() const { return m_image.size(); }
+
+    private:
+        uint16_t TypeAt(ZoneRecord const& zone, int64_t unixSeconds) const;
+        std::string_view String(uint32_t offset, uint32_t length) const;
+
+        std::vector<uint8_t>        m_image;
+        ZoneDatabaseHeader const*   m_header;
+        ZoneRecord const*           m_zones;
+        LocalTimeType const*        m_types;
+        ZoneRule const*             m_rules;
+        TransitionRun const*        m_runs;
+        uint32_t const*             m_transitionTimes;
+        uint8_t const*              m_transitionTypes;
+        uint16_t const*             m_palette;
+        char const*                 m_strings;
+    };
+
+    // Instant (UTC seconds) at which a POSIX TZ transition rule fires in 'year', given the
+    // UTC offset in effect just before it.
+    int64_t TransitionInstant(TransitionRule const& rule, int32_t year, int32_t offsetBefore);
+
+    // Local time type selected by a POSIX TZ rule at an instant.
+    uint16_t EvaluateZoneRule(ZoneRule const& rule, _In_ LocalTimeType const* types, int64_t unixSeconds);
+
+    // First instant after 'unixSeconds' at which a POSIX TZ rule switches types, or INT64_MAX.
+    int64_t NextZoneRuleTransition(ZoneRule const& rule, _In_ LocalTimeType const* types, int64_t unixSeconds);
+}
@@ -0,0 +1,633 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "pch.h"
+#include "ZoneDatabaseBuilder.h"
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <tuple>
+
+using namespace winrt;
+using namespace winrt::SDKTemplate::CalendarEngine;
+
+namespace
+{
+    const size_t TzifHeaderSize = 44;
+
+    struct TzifCounts
+    {
+        uint32_t isUtCount;
+        uint32_t isStdCount;
+        uint32_t leapCount;
+        uint32_t timeCount;
+        uint32_t typeCount;
+        uint32_t charCount;
+
+        uint64_t DataSize(uint32_t timeSize) const
+        {
+            return static_cast<uint64_t>(timeCount) * (timeSize + 1) +
+                static_cast<uint64_t>(typeCount) * 6 +
+                charCount +
+                static_cast<uint64_t>(leapCount) * (timeSize + 4) +
+                isStdCount +
+                isUtCount;
+        }
+    };
+
+    inline uint32_t ReadBigEndian32(uint8_t const* p)
+    {
+        return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+            (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+    }
+
+    inline uint64_t ReadBigEndian64(uint8_t const* p)
+    {
+        return (static_cast<uint64_t>(ReadBigEndian32(p)) << 32) | ReadBigEndian32(p + 4);
+    }
+
+    bool ReadTzifHeader(uint8_t const* p, size_t available, _Out_ uint8_t* version, _Out_ TzifCounts* counts)
+    {
+        if (available < TzifHeaderSize || std::memcmp(p, "TZif", 4) != 0)
+        {
+            return false;
+        }
+        *version = p[4];
+        counts->isUtCount = ReadBigEndian32(p + 20);
+        counts->isStdCount = ReadBigEndian32(p + 24);
+        counts->leapCount = ReadBigEndian32(p + 28);
+        counts->timeCount = ReadBigEndian32(p + 32);
+        counts->typeCount = ReadBigEndian32(p + 36);
+        counts->charCount = ReadBigEndian32(p + 40);
+        return counts->typeCount != 0 && counts->typeCount <= 256 && counts->charCount != 0;
+    }
+
+    inline int32_t YearOf(int64_t unixSeconds)
+    {
+        return CivilFromDays(static_cast<int32_t>(unixSeconds >= 0 ? unixSeconds / 86400 : (unixSeconds - 86399) / 86400)).year;
+    }
+
+    // True if the rule switches between standard and daylight time anywhere in (from, to).
+    bool RuleChangesWithin(ZoneRule const& rule, LocalTimeType const* types, int64_t from, int64_t to)
+    {
+        if (rule.daylightType == NoLocalTimeType)
+        {
+            return false;
+        }
+        int32_t standardOffset = types[rule.standardType].utcOffset;
+        int32_t daylightOffset = types[rule.daylightType].utcOffset;
+        for (int32_t year = YearOf(from) - 1; year <= YearOf(to) + 1; year++)
+        {
+            int64_t start = TransitionInstant(rule.start, year, standardOffset);
+            int64_t end = TransitionInstant(rule.end, year, daylightOffset);
+            if ((start > from && start < to) || (end > from && end < to))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Small cursor over the POSIX TZ string of a TZif footer.
+    class PosixTzReader
+    {
+    public:
+        explicit PosixTzReader(std::string_view text) : m_text(text) {}
+
+        bool AtEnd() const { return m_position == m_text.size(); }
+        char Peek() const { return AtEnd() ? '\0' : m_text[m_position]; }
+
+        bool Consume(char c)
+        {
+            if (Peek() == c)
+            {
+                m_position++;
+                return true;
+            }
+            return false;
+        }
+
+        bool ReadName(std::string& name)
+        {
+            size_t start = m_position;
+            if (Consume('<'))
+            {
+                size_t close = m_text.find('>', m_position);
+                if (close == std::string_view::npos)
+                {
+                    return false;
+                }
+                name = std::string(m_text.substr(m_position, close - m_position));
+                m_position = close + 1;
+            }
+            else
+            {
+                while (!AtEnd() && ((Peek() >= 'A' && Peek() <= 'Z') || (Peek() >= 'a' && Peek() <= 'z')))
+                {
+                    m_position++;
+                }
+                name = std::string(m_text.substr(start, m_position - start));
+            }
+            return name.size() >= 3;
+        }
+
+        bool ReadNumber(uint32_t maxDigits, _Out_ int32_t* value)
+        {
+            *value = 0;
+            uint32_t digits = 0;
+            while (digits < maxDigits && Peek() >= '0' && Peek() <= '9')
+            {
+                *value = *value * 10 + (m_text[m_position++] - '0');
+                digits++;
+            }
+            return digits > 0;
+        }
+
+        // [+|-]hh[:mm[:ss]], returned in seconds.
+        bool ReadTime(_Out_ int32_t* seconds)
+        {
+            int32_t sign = 1;
+            if (Consume('-'))
+            {
+                sign = -1;
+            }
+            else
+            {
+                Consume('+');
+            }
+
+            int32_t hours, minutes = 0, secs = 0;
+            if (!ReadNumber(3, &hours) ||
+                (Consume(':') && (!ReadNumber(2, &minutes) || (Consume(':') && !ReadNumber(2, &secs)))))
+            {
+                return false;
+            }
+            *seconds = sign * (hours * 3600 + minutes * 60 + secs);
+            return true;
+        }
+
+        bool ReadRule(TransitionRule& rule)
+        {
+            rule = {};
+            int32_t value;
+            if (Consume('J'))
+            {
+                rule.kind = TransitionRuleKind::JulianNoLeap;
+                if (!ReadNumber(3, &value) || value < 1 || value > 365)
+                {
+                    return false;
+                }
+                rule.day = static_cast<uint16_t>(value);
+            }
+            else if (Consume('M'))
+            {
+                int32_t month, week, weekday;
+                rule.kind = TransitionRuleKind::MonthWeekDay;
+                if (!ReadNumber(2, &month) || !Consume('.') || !ReadNumber(1, &week) || !Consume('.') || !ReadNumber(1, &weekday) ||
+                    month < 1 || month > 12 || week < 1 || week > 5 || weekday > 6)
+                {
+                    return false;
+                }
+                rule.month = static_cast<uint8_t>(month);
+                rule.week = static_cast<uint8_t>(week);
+                rule.weekday = static_cast<uint8_t>(weekday);
+            }
+            else
+            {
+                rule.kind = TransitionRuleKind::JulianZeroBased;
+                if (!ReadNumber(3, &value) || value > 365)
+                {
+                    return false;
+                }
+                rule.day = static_cast<uint16_t>(value);
+            }
+
+            rule.time = 7200;
+            return !Consume('/') || ReadTime(&rule.time);
+        }
+
+    private:
+        std::string_view m_text;
+        size_t m_position = 0;
+    };
+}
+
+bool ZoneDatabaseBuilder::ParsePosixTz(std::string_view footer, PendingZone& zone)
+{
+    auto typeIndex = [&](int32_t utcOffset, bool isDst, std::string const& abbreviation)
+    {
+        for (size_t i = 0; i < zone.types.size(); i++)
+        {
+            auto const& type = zone.types[i];
+            if (type.utcOffset == utcOffset && type.isDst == isDst && type.abbreviation == abbreviation)
+            {
+                return static_cast<uint16_t>(i);
+            }
+        }
+        zone.types.push_back({ utcOffset, isDst, abbreviation });
+        return static_cast<uint16_t>(zone.types.size() - 1);
+    };
+
+    PosixTzReader reader(footer);
+    std::string standardName;
+    int32_t standardOffset;
+    if (!reader.ReadName(standardName) || !reader.ReadTime(&standardOffset))
+    {
+        return false;
+    }
+
+    // POSIX offsets are positive west of Greenwich.
+    zone.rule = {};
+    zone.rule.standardType = typeIndex(-standardOffset, false, standardName);
+    zone.rule.daylightType = NoLocalTimeType;
+    if (reader.AtEnd())
+    {
+        return true;
+    }
+
+    std::string daylightName;
+    int32_t daylightOffset = standardOffset - 3600;
+    if (!reader.ReadName(daylightName) ||
+        (reader.Peek() != ',' && !reader.AtEnd() && !reader.ReadTime(&daylightOffset)))
+    {
+        return false;
+    }
+    zone.rule.daylightType = typeIndex(-daylightOffset, true, daylightName);
+
+    if (reader.AtEnd())
+    {
+        // No explicit dates: POSIX leaves them implementation defined; use the current US rules.
+        zone.rule.start = { TransitionRuleKind::MonthWeekDay, 3, 2, 0, 0, 0, 7200 };
+        zone.rule.end = { TransitionRuleKind::MonthWeekDay, 11, 1, 0, 0, 0, 7200 };
+        return true;
+    }
+    return reader.Consume(',') && reader.ReadRule(zone.rule.start) &&
+        reader.Consume(',') && reader.ReadRule(zone.rule.end) && reader.AtEnd();
+}
+
+void ZoneDatabaseBuilder::AddTzif(std::string name, _In_reads_bytes_(size) void const* data, size_t size)
+{
+    uint8_t const* bytes = static_cast<uint8_t const*>(data);
+    uint8_t version;
+    TzifCounts counts;
+    if (name.empty() || name.size() > UINT16_MAX || !ReadTzifHeader(bytes, size, &version, &counts))
+    {
+        throw hresult_invalid_argument();
+    }
+
+    // Version 2 and later repeat the data with 64-bit times after the version 1 block.
+    uint32_t timeSize = 4;
+    uint8_t const* block = bytes + TzifHeaderSize;
+    uint64_t blockSize = counts.DataSize(4);
+    if (version >= '2')
+    {
+        if (blockSize > size - TzifHeaderSize)
+        {
+            throw hresult_invalid_argument();
+        }
+        size_t secondHeader = TzifHeaderSize + static_cast<size_t>(blockSize);
+        uint8_t secondVersion;
+        if (!ReadTzifHeader(bytes + secondHeader, size - secondHeader, &secondVersion, &counts))
+        {
+            throw hresult_invalid_argument();
+        }
+        timeSize = 8;
+        block = bytes + secondHeader + TzifHeaderSize;
+        blockSize = counts.DataSize(8);
+    }
+    if (blockSize > size - static_cast<size_t>(block - bytes))
+    {
+        throw hresult_invalid_argument();
+    }
+
+    PendingZone zone = {};
+    zone.name = std::move(name);
+
+    uint8_t const* times = block;
+    uint8_t const* indices = times + static_cast<size_t>(counts.timeCount) * timeSize;
+    uint8_t const* types = indices + counts.timeCount;
+    char const* chars = reinterpret_cast<char const*>(types + static_cast<size_t>(counts.typeCount) * 6);
+
+    for (uint32_t i = 0; i < counts.typeCount; i++)
+    {
+        uint8_t const* record = types + i * 6;
+        uint32_t abbreviationIndex = record[5];
+        if (abbreviationIndex >= counts.charCount || record[4] > 1)
+        {
+            throw hresult_invalid_argument();
+        }
+        char const* abbreviation = chars + abbreviationIndex;
+        size_t length = strnlen(abbreviation, counts.charCount - abbreviationIndex);
+        zone.types.push_back({ static_cast<int32_t>(ReadBigEndian32(record)), record[4] != 0, std::string(abbreviation, length) });
+    }
+
+    for (uint32_t i = 0; i < counts.timeCount; i++)
+    {
+        int64_t time = (timeSize == 8) ?
+            static_cast<int64_t>(ReadBigEndian64(times + i * 8)) :
+            static_cast<int64_t>(static_cast<int32_t>(ReadBigEndian32(times + i * 4)));
+        if (indices[i] >= counts.typeCount || (i > 0 && time <= zone.transitionTimes.back()))
+        {
+            throw hresult_invalid_argument();
+        }
+        zone.transitionTimes.push_back(time);
+        zone.transitionTypes.push_back(indices[i]);
+    }
+
+    // The footer is "\n<POSIX TZ>\n"; an empty TZ string means "no rule".
+    zone.hasRule = false;
+    size_t footerStart = static_cast<size_t>(block - bytes) + static_cast<size_t>(blockSize);
+    if (timeSize == 8 && footerStart < size && bytes[footerStart] == '\n')
+    {
+        char const* footer = reinterpret_cast<char const*>(bytes + footerStart + 1);
+        char const* footerEnd = static_cast<char const*>(std::memchr(footer, '\n', size - footerStart - 1));
+        if (footerEnd == nullptr)
+        {
+            throw hresult_invalid_argument();
+        }
+        if (footerEnd != footer)
+        {
+            if (!ParsePosixTz(std::string_view(footer, footerEnd - footer), zone))
+            {
+                throw hresult_invalid_argument();
+            }
+            zone.hasRule = true;
+        }
+    }
+
+    m_zones.push_back(std::move(zone));
+}
+
+std::vector<uint8_t> ZoneDatabaseBuilder::Build() const
+{
+    std::vector<PendingZone const*> zones;
+    for (auto&& zone : m_zones)
+    {
+        zones.push_back(&zone);
+    }
+    std::sort(zones.begin(), zones.end(), [](PendingZone const* left, PendingZone const* right)
+    {
+        return left->name < right->name;
+    });
+    for (size_t i = 1; i < zones.size(); i++)
+    {
+        if (zones[i - 1]->name == zones[i]->name)
+        {
+            throw hresult_invalid_argument();
+        }
+    }
+
+    using Run = std::vector<std::pair<int64_t, uint16_t>>;
+
+    std::vector<ZoneRecord> records;
+    std::vector<LocalTimeType> types;
+    std::vector<ZoneRule> rules;
+    std::vector<TransitionRun> runs(1, TransitionRun{});
+    std::vector<uint32_t> transitionTimes;
+    std::vector<uint8_t> transitionTypes;
+    std::vector<uint16_t> palette;
+    std::string strings;
+
+    std::map<std::string, uint32_t> stringPool;
+    std::map<std::tuple<int32_t, bool, std::string>, uint16_t> typePool;
+    std::map<std::vector<uint8_t>, uint16_t> rulePool;
+    std::map<Run, uint16_t> runPool;
+    std::map<std::vector<uint16_t>, uint16_t> palettePool;
+
+    auto appendString = [&](std::string const& value)
+    {
+        auto found = stringPool.find(value);
+        if (found != stringPool.end())
+        {
+            return found->second;
+        }
+        uint32_t offset = static_cast<uint32_t>(strings.size());
+        strings += value;
+        stringPool.emplace(value, offset);
+        return offset;
+    };
+
+    auto internType = [&](PendingType const& type)
+    {
+        std::string abbreviation = type.abbreviation.substr(0, UINT8_MAX);
+        auto key = std::make_tuple(type.utcOffset, type.isDst, abbreviation);
+        auto found = typePool.find(key);
+        if (found != typePool.end())
+        {
+            return found->second;
+        }
+        LocalTimeType record = {};
+        record.utcOffset = type.utcOffset;
+        record.isDst = type.isDst ? 1 : 0;
+        record.abbreviationLength = static_cast<uint8_t>(abbreviation.size());
+        record.abbreviationOffset = appendString(abbreviation);
+        uint16_t index = static_cast<uint16_t>(types.size());
+        types.push_back(record);
+        typePool.emplace(key, index);
+        return index;
+    };
+
+    auto internRule = [&](ZoneRule const& rule)
+    {
+        std::vector<uint8_t> key(reinterpret_cast<uint8_t const*>(&rule), reinterpret_cast<uint8_t const*>(&rule + 1));
+        auto found = rulePool.find(key);
+        if (found != rulePool.end())
+        {
+            return found->second;
+        }
+        uint16_t index = static_cast<uint16_t>(rules.size());
+        rules.push_back(rule);
+        rulePool.emplace(key, index);
+        return index;
+    };
+
+    auto internPalette = [&](std::vector<uint16_t> const& entries)
+    {
+        auto found = palettePool.find(entries);
+        if (found != palettePool.end())
+        {
+            return found->second;
+        }
+        if (palette.size() > UINT16_MAX)
+        {
+            throw hresult_invalid_argument();
+        }
+        uint16_t first = static_cast<uint16_t>(palette.size());
+        palette.insert(palette.end(), entries.begin(), entries.end());
+        palettePool.emplace(entries, first);
+        return first;
+    };
+
+    // 'era' is the instant the run's 32-bit times count from.
+    auto internRun = [&](Run const& run, int64_t era)
+    {
+        if (run.empty())
+        {
+            return uint16_t(0);
+        }
+        auto found = runPool.find(run);
+        if (found != runPool.end())
+        {
+            return found->second;
+        }
+        if (run.size() > UINT16_MAX || runs.size() > UINT16_MAX)
+        {
+            throw hresult_invalid_argument();
+        }
+
+        std::vector<uint16_t> entries;
+        TransitionRun record = {};
+        record.first = static_cast<uint32_t>(transitionTimes.size());
+        record.count = static_cast<uint16_t>(run.size());
+        for (auto&& transition : run)
+        {
+            auto entry = std::find(entries.begin(), entries.end(), transition.second);
+            if (entry == entries.end())
+            {
+                if (entries.size() > UINT8_MAX)
+                {
+                    throw hresult_invalid_argument();
+                }
+                entry = entries.insert(entries.end(), transition.second);
+            }
+            transitionTimes.push_back(static_cast<uint32_t>(transition.first - era));
+            transitionTypes.push_back(static_cast<uint8_t>(entry - entries.begin()));
+        }
+        record.palette = internPalette(entries);
+
+        uint16_t index = static_cast<uint16_t>(runs.size());
+        runs.push_back(record);
+        runPool.emplace(run, index);
+        return index;
+    };
+
+    for (auto zone : zones)
+    {
+        // Types are pooled on first use so that dropped history does not keep its types.
+        std::vector<uint16_t> zoneTypes(zone->types.size(), NoLocalTimeType);
+        auto typeOf = [&](size_t index)
+        {
+            if (zoneTypes[index] == NoLocalTimeType)
+            {
+                zoneTypes[index] = internType(zone->types[index]);
+            }
+            return zoneTypes[index];
+        };
+
+        // Transitions before the head era (or the requested start) are folded into the initial
+        // type.  Past 2106 the POSIX rule, if any, takes over.
+        auto const& times = zone->transitionTimes;
+        size_t first = std::upper_bound(times.begin(), times.end(), m_earliestInstant) - times.begin();
+
+        ZoneRecord record = {};
+        record.nameLength = static_cast<uint16_t>(zone->name.size());
+        record.nameOffset = appendString(zone->name);
+        record.initialType = typeOf((first == 0) ? 0 : zone->transitionTypes[first - 1]);
+        record.rule = NoZoneRule;
+
+        ZoneRule rule = {};
+        if (zone->hasRule)
+        {
+            rule.standardType = typeOf(zone->rule.standardType);
+            rule.daylightType = (zone->rule.daylightType == NoLocalTimeType) ? NoLocalTimeType : typeOf(zone->rule.daylightType);
+            if (rule.daylightType != NoLocalTimeType)
+            {
+                rule.start = zone->rule.start;
+                rule.end = zone->rule.end;
+            }
+            record.rule = internRule(rule);
+        }
+
+        Run transitions;
+        for (size_t i = first; i < times.size(); i++)
+        {
+            transitions.emplace_back(times[i], typeOf(zone->transitionTypes[i]));
+        }
+
+        // Files built with "zic -b fat" spell out decades of transitions that the POSIX rule
+        // reproduces.  Drop them from the end for as long as the rule agrees on both sides.
+        if (zone->hasRule)
+        {
+            auto ruleAt = [&](int64_t instant) { return EvaluateZoneRule(rule, types.data(), instant); };
+            while (transitions.size() >= 2)
+            {
+                auto const& last = transitions[transitions.size() - 1];
+                auto const& previous = transitions[transitions.size() - 2];
+                if (ruleAt(last.first) != last.second ||
+                    ruleAt(previous.first) != previous.second ||
+                    RuleChangesWithin(rule, types.data(), previous.first, last.first))
+                {
+                    break;
+                }
+                transitions.pop_back();
+            }
+        }
+
+        auto split = std::lower_bound(transitions.begin(), transitions.end(), std::make_pair(int64_t(0), uint16_t(0)));
+        auto eraEnd = std::lower_bound(split, transitions.end(), std::make_pair(int64_t(UINT32_MAX) + 1, uint16_t(0)));
+        record.headRun = internRun(Run(transitions.begin(), split), ZoneDatabase::HeadEra);
+        record.tailRun = internRun(Run(split, eraEnd), 0);
+        records.push_back(record);
+    }
+
+    if (types.size() >= NoLocalTimeType || rules.size() >= NoZoneRule)
+    {
+        throw hresult_invalid_argument();
+    }
+
+    ZoneDatabaseHeader header = {};
+    header.magic = ZoneDatabase::Magic;
+    header.version = ZoneDatabase::Version;
+    std::memcpy(header.tzdataVersion, m_tzdataVersion.data(), std::min(m_tzdataVersion.size(), sizeof(header.tzdataVersion)));
+    header.zoneCount = static_cast<uint32_t>(records.size());
+    header.typeCount = static_cast<uint32_t>(types.size());
+    header.ruleCount = static_cast<uint32_t>(rules.size());
+    header.runCount = static_cast<uint32_t>(runs.size());
+    header.transitionCount = static_cast<uint32_t>(transitionTimes.size());
+    header.paletteCount = static_cast<uint32_t>(palette.size());
+    header.stringBytes = static_cast<uint32_t>(strings.size());
+
+    size_t offset = sizeof(header);
+    auto place = [&](size_t bytes, size_t alignment)
+    {
+        offset = (offset + alignment - 1) & ~(alignment - 1);
+        uint32_t start = static_cast<uint32_t>(offset);
+        offset += bytes;
+        return start;
+    };
+    header.zonesOffset = place(records.size() * sizeof(ZoneRecord), 4);
+    header.typesOffset = place(types.size() * sizeof(LocalTimeType), 4);
+    header.rulesOffset = place(rules.size() * sizeof(ZoneRule), 4);
+    header.runsOffset = place(runs.size() * sizeof(TransitionRun), 4);
+    header.transitionTimesOffset = place(transitionTimes.size() * sizeof(uint32_t), 4);
+    header.transitionTypesOffset = place(transitionTypes.size() * sizeof(uint8_t), 1);
+    header.paletteOffset = place(palette.size() * sizeof(uint16_t), 2);
+    header.stringsOffset = place(strings.size(), 1);
+
+    std::vector<uint8_t> image(offset, 0);
+    auto copy = [&](uint32_t at, void const* source, size_t bytes)
+    {
+        if (bytes != 0)
+        {
+            std::memcpy(image.data() + at, source, bytes);
+        }
+    };
+    copy(0, &header, sizeof(header));
+    copy(header.zonesOffset, records.data(), records.size() * sizeof(ZoneRecord));
+    copy(header.typesOffset, types.data(), types.size() * sizeof(LocalTimeType));
+    copy(header.rulesOffset, rules.data(), rules.size() * sizeof(ZoneRule));
+    copy(header.runsOffset, runs.data(), runs.size() * sizeof(TransitionRun));
+    copy(header.transitionTimesOffset, transitionTimes.data(), transitionTimes.size() * sizeof(uint32_t));
+    copy(header.transitionTypesOffset, transitionTypes.data(), transitionTypes.size() * sizeof(uint8_t));
+    copy(header.paletteOffset, palette.data(), palette.size() * sizeof(uint16_t));
+    copy(header.stringsOffset, strings.data(), strings.size());
+    return image;
+}
@@ -0,0 +1,73 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+// ZoneDatabaseBuilder:
+// Compiles TZif files (RFC 8536, versions 1 through 4) into a ZoneDatabase image.
+// The 64-bit data block is used when present, and the POSIX TZ footer is compiled into a
+// ZoneRule so that instants past the last transition do not need the file any more.
+// Leap second records are ignored; use the "posix" rather than the "right" zones.
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ZoneDatabase.h"
+
+namespace winrt::SDKTemplate::CalendarEngine
+{
+    class ZoneDatabaseBuilder
+    {
+    public:
+        void TzdataVersion(std::string_view version) { m_tzdataVersion = version; }
+
+        // Drops the history before an instant, like "zic -r"; lookups before it are not
+        // meaningful.  Building from 1970 (instant 0) roughly halves the image.
+        void EarliestInstant(int64_t unixSeconds) { m_earliestInstant = (unixSeconds < ZoneDatabase::HeadEra) ? int64_t(ZoneDatabase::HeadEra) : unixSeconds; }
+
+        // Throws hresult_invalid_argument if the data is not a well-formed TZif file.
+        void AddTzif(std::string name, _In_reads_bytes_(size) void const* data, size_t size);
+
+        std::vector<uint8_t> Build() const;
+
+    private:
+        struct PendingType
+        {
+            int32_t     utcOffset;
+            bool        isDst;
+            std::string abbreviation;
+        };
+
+        struct PendingRule
+        {
+            uint16_t       standardType;        // Indices into the zone's own types.
+            uint16_t       daylightType;
+            TransitionRule start;
+            TransitionRule end;
+        };
+
+        struct PendingZone
+        {
+            std::string              name;
+            std::vector<PendingType> types;
+            std::vector<int64_t>     transitionTimes;
+            std::vector<uint8_t>     transitionTypes;
+            bool                     hasRule;
+            PendingRule              rule;
+        };
+
+        static bool ParsePosixTz(std::string_view footer, PendingZone& zone);
+
+        std::string              m_tzdataVersion;
+        int64_t                  m_earliestInstant = ZoneDatabase::HeadEra;
+        std::vector<PendingZone> m_zones;
+    };
+}
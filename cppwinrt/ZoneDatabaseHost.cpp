@@ -0,0 +1,123 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "pch.h"
+#include "ZoneDatabaseHost.h"
+#include <algorithm>
+
+using namespace winrt;
+using namespace winrt::SDKTemplate::CalendarEngine;
+
+// All of the atomics below use the default sequentially consistent ordering.  The
+// protocol relies on it: a reader's epoch store and a writer's pointer exchange must be
+// seen in the same order by both sides.
+
+ZoneDatabaseHost::ZoneDatabaseHost(std::unique_ptr<ZoneDatabase const> database) :
+    m_current(database.release())
+{
+    if (m_current.load() == nullptr)
+    {
+        throw hresult_invalid_argument();
+    }
+}
+
+ZoneDatabaseHost::~ZoneDatabaseHost()
+{
+    // Every cursor must be gone by now; the retired versions go with m_retired.
+    delete m_current.load();
+}
+
+uint32_t ZoneDatabaseHost::ClaimSlot()
+{
+    for (uint32_t slot = 0; slot < MaxCursors; slot++)
+    {
+        bool expected = false;
+        if (!m_slots[slot].claimed.load() && m_slots[slot].claimed.compare_exchange_strong(expected, true))
+        {
+            return slot;
+        }
+    }
+    throw hresult_illegal_method_call(L"Too many zone cursors are open.");
+}
+
+void ZoneDatabaseHost::ReleaseSlot(uint32_t slot)
+{
+    m_slots[slot].epoch.store(0);
+    m_slots[slot].claimed.store(false);
+}
+
+ZoneDatabase const* ZoneDatabaseHost::Pin(uint32_t slot)
+{
+    // Announce the epoch first, then read the pointer.  A writer that retires the version
+    // we load will either see this epoch or will have published before our load.
+    m_slots[slot].epoch.store(m_epoch.load());
+    return m_current.load();
+}
+
+void ZoneDatabaseHost::Publish(std::unique_ptr<ZoneDatabase const> database)
+{
+    if (database == nullptr)
+    {
+        throw hresult_invalid_argument();
+    }
+
+    std::lock_guard<std::mutex> lock(m_writerLock);
+    ZoneDatabase const* previous = m_current.exchange(database.release());
+    uint64_t epoch = m_epoch.fetch_add(1) + 1;
+    m_retired.push_back({ epoch, std::unique_ptr<ZoneDatabase const>(previous) });
+    ReclaimLocked();
+}
+
+size_t ZoneDatabaseHost::Reclaim()
+{
+    std::lock_guard<std::mutex> lock(m_writerLock);
+    return ReclaimLocked();
+}
+
+size_t ZoneDatabaseHost::ReclaimLocked()
+{
+    // A version retired at epoch E was current for every reader that pinned before E.
+    // Once the oldest active pin is at E or later, nobody can hold it.
+    uint64_t oldest = UINT64_MAX;
+    for (auto&& slot : m_slots)
+    {
+        uint64_t slotEpoch = slot.epoch.load();
+        if (slotEpoch != 0)
+        {
+            oldest = std::min(oldest, slotEpoch);
+        }
+    }
+    m_retired.erase(
+        std::remove_if(m_retired.begin(), m_retired.end(), [&](RetiredVersion const& retired) { return retired.epoch <= oldest; }),
+        m_retired.end());
+    return m_retired.size();
+}
+
+//----------------------------------------------------------------------
+
+ZoneCursor::ZoneCursor(ZoneDatabaseHost& host) :
+    m_host(host),
+    m_slot(host.ClaimSlot())
+{
+    m_database = m_host.Pin(m_slot);
+}
+
+ZoneCursor::~ZoneCursor()
+{
+    m_host.ReleaseSlot(m_slot);
+}
+
+bool ZoneCursor::Refresh()
+{
+    ZoneDatabase const* previous = m_database;
+    m_database = m_host.Pin(m_slot);
+    return m_database != previous;
+}
@@ -0,0 +1,104 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+// ZoneDatabaseHost:
+// Holds the current ZoneDatabase of a long-running process and lets a new tzdata build
+// be published while readers keep running.
+//
+// Readers go through a ZoneCursor.  A cursor claims one reader slot when it is created
+// and pins the version that was current at that moment; Refresh moves it to the latest
+// version.  Pinning is an epoch store followed by a pointer load, so readers never wait
+// for writers or for each other.
+//
+// Publish swaps the current pointer, advances the global epoch and retires the previous
+// version tagged with the new epoch.  A retired version is destroyed by Reclaim (called
+// from every Publish) once no active reader slot holds an older epoch, which means no
+// cursor can still be looking at it.
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "ZoneDatabase.h"
+
+namespace winrt::SDKTemplate::CalendarEngine
+{
+    class ZoneDatabaseHost
+    {
+    public:
+        static const uint32_t MaxCursors = 256;
+
+        explicit ZoneDatabaseHost(std::unique_ptr<ZoneDatabase const> database);
+        ~ZoneDatabaseHost();
+
+        ZoneDatabaseHost(ZoneDatabaseHost const&) = delete;
+        ZoneDatabaseHost& operator=(ZoneDatabaseHost const&) = delete;
+
+        // Makes 'database' current.  Writers are serialized; readers are never blocked.
+        void Publish(std::unique_ptr<ZoneDatabase const> database);
+
+        // Destroys retired versions that no cursor can reach; returns how many are still pending.
+        size_t Reclaim();
+
+        uint64_t Generation() const { return m_epoch.load(); }
+
+    private:
+        friend class ZoneCursor;
+
+        struct alignas(64) ReaderSlot
+        {
+            std::atomic<bool>     claimed{ false };
+            std::atomic<uint64_t> epoch{ 0 };       // Zero while the slot is idle.
+        };
+
+        struct RetiredVersion
+        {
+            uint64_t                            epoch;
+            std::unique_ptr<ZoneDatabase const> database;
+        };
+
+        uint32_t ClaimSlot();
+        void ReleaseSlot(uint32_t slot);
+        ZoneDatabase const* Pin(uint32_t slot);
+        size_t ReclaimLocked();
+
+        std::atomic<ZoneDatabase const*>    m_current;
+        std::atomic<uint64_t>               m_epoch{ 1 };
+        std::array<ReaderSlot, MaxCursors>  m_slots;
+        std::mutex                          m_writerLock;
+        std::vector<RetiredVersion>         m_retired;
+    };
+
+    // A reader's view of the host.  Not thread safe; each thread uses its own cursor.
+    class ZoneCursor
+    {
+    public:
+        explicit ZoneCursor(ZoneDatabaseHost& host);
+        ~ZoneCursor();
+
+        ZoneCursor(ZoneCursor const&) = delete;
+        ZoneCursor& operator=(ZoneCursor const&) = delete;
+
+        ZoneDatabase const& Database() const { return *m_database; }
+        ZoneDatabase const* operator->() const { return m_database; }
+
+        // Moves to the latest published version.  Returns true if the version changed.
+        bool Refresh();
+
+    private:
+        ZoneDatabaseHost&   m_host;
+        uint32_t            m_slot;
+        ZoneDatabase const* m_database;
+    };
+}
@@ -0,0 +1,154 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "pch.h"
+#include "ZoneDisplayNames.h"
+#include "CalendarMetrics.h"
+#include <algorithm>
+
+using namespace winrt;
+using namespace Windows::Foundation;
+using namespace Windows::Globalization::DateTimeFormatting;
+using namespace winrt::SDKTemplate::CalendarEngine;
+
+namespace
+{
+    inline int64_t YearStart(int32_t year)
+    {
+        return static_cast<int64_t>(DaysFromCivil(year, 1, 1)) * 86400;
+    }
+
+    ZoneDisplayNames::Resolver FormatterResolver(ZoneDatabase const& database, hstring const& language)
+    {
+        DateTimeFormatter abbreviated(L"{timezone.abbreviated}", { language });
+        DateTimeFormatter full(L"{timezone.full}", { language });
+        return [&database, abbreviated, full](uint32_t zone, int64_t unixSeconds, std::wstring& abbreviation, std::wstring& displayName)
+        {
+            try
+            {
+                hstring zoneName = to_hstring(database.ZoneName(zone));
+                DateTime instant = clock::from_time_t(static_cast<time_t>(unixSeconds));
+                abbreviation = CALENDAR_ENGINE_MEASURE(CalendarOperation::Format, abbreviated.Format(instant, zoneName));
+                displayName = CALENDAR_ENGINE_MEASURE(CalendarOperation::Format, full.Format(instant, zoneName));
+            }
+            catch (hresult_error const&)
+            {
+                // Windows does not know this zone; the caller falls back to tzdata.
+            }
+        };
+    }
+}
+
+ZoneDisplayNames::ZoneDisplayNames(ZoneDatabase const& database, hstring const& language, int32_t firstYear, int32_t lastYear) :
+    ZoneDisplayNames(database, firstYear, lastYear, FormatterResolver(database, language))
+{
+}
+
+ZoneDisplayNames::ZoneDisplayNames(ZoneDatabase const& database, int32_t firstYear, int32_t lastYear, Resolver const& resolver)
+{
+    CALENDAR_ENGINE_TIME_SCOPE(CalendarOperation::ZoneNamesBuild);
+    if (firstYear > lastYear || firstYear < 1 || lastYear > 9999)
+    {
+        throw hresult_invalid_argument();
+    }
+
+    int64_t rangeStart = YearStart(firstYear);
+    int64_t rangeEnd = YearStart(lastYear + 1);
+    std::map<std::wstring, NameRef> pool;
+    std::wstring abbreviation;
+    std::wstring displayName;
+
+    for (uint32_t zone = 0; zone < database.ZoneCount(); zone++)
+    {
+        uint32_t zoneFirst = static_cast<uint32_t>(m_entries.size());
+        m_zoneFirst.push_back(zoneFirst);
+
+        for (int64_t instant = rangeStart; instant < rangeEnd;)
+        {
+            LocalTimeInfo info = database.Lookup(zone, instant);
+            int64_t next = database.NextTransition(zone, instant);
+            bool known = std::any_of(m_entries.begin() + zoneFirst, m_entries.end(), [&](Entry const& entry) { return entry.type == info.type; });
+            if (!known)
+            {
+                // Ask in the middle of the interval, away from where the two sources might
+                // disagree about the exact transition instant.
+                abbreviation.clear();
+                displayName.clear();
+                resolver(zone, instant + (std::min(next, rangeEnd) - instant) / 2, abbreviation, displayName);
+                if (abbreviation.empty())
+                {
+                    abbreviation.assign(info.abbreviation.begin(), info.abbreviation.end());
+                }
+                if (displayName.empty())
+                {
+                    displayName = abbreviation;
+                }
+                m_entries.push_back({ info.type, Intern(abbreviation, pool), Intern(displayName, pool) });
+            }
+            instant = next;
+        }
+    }
+    m_zoneFirst.push_back(static_cast<uint32_t>(m_entries.size()));
+}
+
+ZoneDisplayNames::NameRef ZoneDisplayNames::Intern(std::wstring const& name, std::map<std::wstring, NameRef>& pool)
+{
+    auto found = pool.find(name);
+    if (found != pool.end())
+    {
+        return found->second;
+    }
+    NameRef ref = { static_cast<uint32_t>(m_strings.size()), static_cast<uint32_t>(name.size()) };
+    m_strings += name;
+    pool.emplace(name, ref);
+    return ref;
+}
+
+uint32_t ZoneDisplayNames::Handle(uint32_t zone, uint16_t type) const
+{
+    if (zone >= m_zoneFirst.size() - 1)
+    {
+        return NoHandle;
+    }
+    for (uint32_t entry = m_zoneFirst[zone]; entry < m_zoneFirst[zone + 1]; entry++)
+    {
+        if (m_entries[entry].type == type)
+        {
+            return entry;
+        }
+    }
+    return NoHandle;
+}
+
+//----------------------------------------------------------------------
+
+ZoneDisplayNameCache::ZoneDisplayNameCache(ZoneDatabase const& database, int32_t firstYear, int32_t lastYear) :
+    m_database(database),
+    m_firstYear(firstYear),
+    m_lastYear(lastYear)
+{
+}
+
+ZoneDisplayNames const& ZoneDisplayNameCache::ForLanguage(hstring const& language)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    auto& table = m_tables[std::wstring(language)];
+    if (table == nullptr)
+    {
+        CALENDAR_ENGINE_COUNT(CalendarCounter::ZoneNameCacheMiss);
+        table = std::make_unique<ZoneDisplayNames>(m_database, language, m_firstYear, m_lastYear);
+    }
+    else
+    {
+        CALENDAR_ENGINE_COUNT(CalendarCounter::ZoneNameCacheHit);
+    }
+    return *table;
+}
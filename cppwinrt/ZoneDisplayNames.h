@@ -0,0 +1,92 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+// ZoneDisplayNames:
+// Localized time zone abbreviations ("EST", "IST") and display names for one language,
+// resolved once for every local time type each zone uses in a range of years.  After
+// that, formatting a zone name is ZoneDatabase::Lookup followed by Handle, which is an
+// index, and Abbreviation or DisplayName, which are string views into the table.
+//
+// Names are resolved through DateTimeFormatter by default.  Where Windows has no name
+// for a zone, the tzdata abbreviation is used.  ZoneDisplayNameCache keeps one table per
+// language and builds it on first use.
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ZoneDatabase.h"
+
+namespace winrt::SDKTemplate::CalendarEngine
+{
+    class ZoneDisplayNames
+    {
+    public:
+        static const uint32_t NoHandle = UINT32_MAX;
+
+        // Fills in the names of 'zone' at an instant; either may be left empty.
+        using Resolver = std::function<void(uint32_t zone, int64_t unixSeconds, std::wstring& abbreviation, std::wstring& displayName)>;
+
+        // Resolves the names of the UTC years [firstYear, lastYear] in 'language'.
+        ZoneDisplayNames(ZoneDatabase const& database, hstring const& language, int32_t firstYear, int32_t lastYear);
+        ZoneDisplayNames(ZoneDatabase const& database, int32_t firstYear, int32_t lastYear, Resolver const& resolver);
+
+        // 'type' is LocalTimeInfo::type.  Returns NoHandle if the zone never used the type in
+        // the resolved years.
+        uint32_t Handle(uint32_t zone, uint16_t type) const;
+
+        std::wstring_view Abbreviation(uint32_t handle) const { return Name(m_entries[handle].abbreviation); }
+        std::wstring_view DisplayName(uint32_t handle) const { return Name(m_entries[handle].displayName); }
+
+    private:
+        struct NameRef
+        {
+            uint32_t offset;
+            uint32_t length;
+        };
+
+        struct Entry
+        {
+            uint16_t type;
+            NameRef  abbreviation;
+            NameRef  displayName;
+        };
+
+        NameRef Intern(std::wstring const& name, std::map<std::wstring, NameRef>& pool);
+        std::wstring_view Name(NameRef name) const { return std::wstring_view(m_strings.data() + name.offset, name.length); }
+
+        std::vector<uint32_t> m_zoneFirst;      // Entries of zone z are [m_zoneFirst[z], m_zoneFirst[z + 1]).
+        std::vector<Entry>    m_entries;
+        std::wstring          m_strings;
+    };
+
+    class ZoneDisplayNameCache
+    {
+    public:
+        // The database must outlive the cache.
+        ZoneDisplayNameCache(ZoneDatabase const& database, int32_t firstYear, int32_t lastYear);
+
+        // Thread safe.  The returned table lives as long as the cache.
+        ZoneDisplayNames const& ForLanguage(hstring const& language);
+
+    private:
+        ZoneDatabase const&                                       m_database;
+        int32_t                                                   m_firstYear;
+        int32_t                                                   m_lastYear;
+        std::mutex                                                m_lock;
+        std::map<std::wstring, std::unique_ptr<ZoneDisplayNames>> m_tables;
+    };
+}
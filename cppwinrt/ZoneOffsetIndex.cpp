@@ -0,0 +1,120 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#include "pch.h"
+#include "ZoneOffsetIndex.h"
+#include <algorithm>
+#include <map>
+
+using namespace winrt;
+using namespace winrt::SDKTemplate::CalendarEngine;
+
+namespace
+{
+    inline int64_t FloorDiv(int64_t value, int64_t divisor)
+    {
+        return (value >= 0) ? value / divisor : (value - divisor + 1) / divisor;
+    }
+
+    inline int64_t YearStart(int32_t year)
+    {
+        return static_cast<int64_t>(DaysFromCivil(year, 1, 1)) * 86400;
+    }
+}
+
+ZoneOffsetIndex::ZoneOffsetIndex(ZoneDatabase const& database, int32_t firstYear, int32_t lastYear) :
+    m_firstYear(firstYear),
+    m_lastYear(lastYear)
+{
+    if (firstYear > lastYear || firstYear < 1 || lastYear > 9999)
+    {
+        throw hresult_invalid_argument();
+    }
+
+    // Zones are visited in index order, so every bucket comes out sorted.
+    std::unordered_map<uint64_t, std::vector<uint32_t>> buckets;
+    std::vector<uint64_t> keys;
+    for (uint32_t zone = 0; zone < database.ZoneCount(); zone++)
+    {
+        for (int32_t year = firstYear; year <= lastYear; year++)
+        {
+            int64_t instant = YearStart(year);
+            int64_t yearEnd = YearStart(year + 1);
+            keys.clear();
+            while (true)
+            {
+                LocalTimeInfo info = database.Lookup(zone, instant);
+                uint64_t key = Key(info.utcOffset, info.isDst, year);
+                if (std::find(keys.begin(), keys.end(), key) == keys.end())
+                {
+                    keys.push_back(key);
+                    buckets[key].push_back(zone);
+                }
+                instant = database.NextTransition(zone, instant);
+                if (instant >= yearEnd)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    std::map<std::vector<uint32_t>, uint32_t> pool;
+    for (auto&& bucket : buckets)
+    {
+        auto found = pool.find(bucket.second);
+        uint32_t first;
+        if (found != pool.end())
+        {
+            first = found->second;
+        }
+        else
+        {
+            first = static_cast<uint32_t>(m_zones.size());
+            m_zones.insert(m_zones.end(), bucket.second.begin(), bucket.second.end());
+            pool.emplace(bucket.second, first);
+        }
+        m_lists.emplace(bucket.first, CandidateList{ first, static_cast<uint32_t>(bucket.second.size()) });
+    }
+}
+
+uint64_t ZoneOffsetIndex::Key(int32_t utcOffset, bool isDst, int32_t year)
+{
+    // Years are limited to 1..9999, so 15 bits of the low word hold them.
+    return (static_cast<uint64_t>(static_cast<uint32_t>(utcOffset)) << 32) |
+        (static_cast<uint64_t>(year) << 1) |
+        (isDst ? 1 : 0);
+}
+
+array_view<uint32_t const> ZoneOffsetIndex::Candidates(int32_t utcOffset, bool isDst, int32_t year) const
+{
+    if (year < m_firstYear || year > m_lastYear)
+    {
+        return {};
+    }
+    auto found = m_lists.find(Key(utcOffset, isDst, year));
+    if (found == m_lists.end())
+    {
+        return {};
+    }
+    uint32_t const* first = m_zones.data() + found->second.first;
+    return { first, first + found->second.count };
+}
+
+array_view<uint32_t const> ZoneOffsetIndex::CandidatesAt(int32_t utcOffset, bool isDst, int64_t unixSeconds) const
+{
+    int64_t day = FloorDiv(unixSeconds, 86400);
+    if (day < INT32_MIN || day > INT32_MAX)
+    {
+        return {};
+    }
+    return Candidates(utcOffset, isDst, CivilFromDays(static_cast<int32_t>(day)).year);
+}
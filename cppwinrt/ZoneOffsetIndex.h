@@ -0,0 +1,59 @@
+//*********************************************************
+//
+// Copyright (c) Microsoft. All rights reserved.
+// This code is licensed under the MIT License (MIT).
+// THIS CODE IS PROVIDED *AS IS* WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING ANY
+// IMPLIED WARRANTIES OF FITNESS FOR A PARTICULAR
+// PURPOSE, MERCHANTABILITY, OR NON-INFRINGEMENT.
+//
+//*********************************************************
+
+#pragma once
+
+// ZoneOffsetIndex:
+// The reverse of ZoneDatabase::Lookup.  Given a UTC offset, a daylight saving flag and a
+// year, returns the zones that used that offset with that flag at some point of the year,
+// for records that carry an offset but no zone name.
+//
+// The index is built once by walking every zone's transitions through the indexed years.
+// Each (offset, DST, year) key maps to a sorted list of zone indices; identical lists are
+// stored once, so a run of years with the same candidates shares one list.  A query is a
+// single hash lookup.
+
+#include <unordered_map>
+#include <vector>
+#include "ZoneDatabase.h"
+
+namespace winrt::SDKTemplate::CalendarEngine
+{
+    class ZoneOffsetIndex
+    {
+    public:
+        // Indexes the UTC calendar years [firstYear, lastYear] of every zone in 'database'.
+        ZoneOffsetIndex(ZoneDatabase const& database, int32_t firstYear, int32_t lastYear);
+
+        int32_t FirstYear() const { return m_firstYear; }
+        int32_t LastYear() const { return m_lastYear; }
+
+        // Zone indices in ascending order; empty for years outside the index.
+        array_view<uint32_t const> Candidates(int32_t utcOffset, bool isDst, int32_t year) const;
+
+        // Candidates for the UTC year that contains the instant.
+        array_view<uint32_t const> CandidatesAt(int32_t utcOffset, bool isDst, int64_t unixSeconds) const;
+
+    private:
+        struct CandidateList
+        {
+            uint32_t first;
+            uint32_t count;
+        };
+
+        static uint64_t Key(int32_t utcOffset, bool isDst, int32_t year);
+
+        int32_t                                     m_firstYear;
+        int32_t                                     m_lastYear;
+        std::vector<uint32_t>                       m_zones;
+        std::unordered_map<uint64_t, CandidateList> m_lists;
+    };
+}